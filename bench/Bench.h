@@ -0,0 +1,31 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdint>
+
+// Minimal timing helpers shared by the benchmarks
+class BenchTimer {
+private:
+    std::chrono::steady_clock::time_point start;
+    
+public:
+    BenchTimer() : start(std::chrono::steady_clock::now()) {}
+    
+    double elapsedSeconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Keeps the optimiser from discarding work whose result is otherwise unused
+inline void benchConsume(uint64_t value) {
+    static volatile uint64_t sink;
+    sink = sink + value;
+}
+
+// Each benchmark lives in its own file and prints its own results
+void benchBlockLookups();
+void benchMeshing();
+void benchCollision();
+
+#endif // BENCH_H
@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include "World.h"
+#include "Random.h"
+#include <iostream>
+#include <vector>
+
+// World::getBlockAt throughput over the generated spawn area, for scattered and
+// for cache-friendly (column-by-column) access patterns
+void benchBlockLookups() {
+    const int RANDOM_LOOKUPS = 4000000;
+    const int PASSES = 5;
+    
+    World world(DEFAULT_WORLD_SEED);
+    world.generateWorld();
+    
+    // Spawn columns span chunks -SPAWN_RADIUS..SPAWN_RADIUS around the origin;
+    // lookups cover the terrain band of the square inside them, negative half included
+    const int minXZ = -SPAWN_RADIUS * CHUNK_WIDTH / 2;
+    const int maxXZ = SPAWN_RADIUS * CHUNK_WIDTH / 2 + CHUNK_WIDTH;
+    const int maxY = 96;
+    const int span = maxXZ - minXZ;
+    
+    std::vector<int> coords(RANDOM_LOOKUPS * 3);
+    CounterRandom rng(12345);
+    for (int i = 0; i < RANDOM_LOOKUPS; i++) {
+        coords[i * 3 + 0] = minXZ + rng.nextInt(span);
+        coords[i * 3 + 1] = rng.nextInt(maxY);
+        coords[i * 3 + 2] = minXZ + rng.nextInt(span);
+    }
+    
+    uint64_t checksum = 0;
+    BenchTimer randomTimer;
+    for (int pass = 0; pass < PASSES; pass++) {
+        for (int i = 0; i < RANDOM_LOOKUPS; i++) {
+            checksum += world.getBlockAt(coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]).type;
+        }
+    }
+    double randomSeconds = randomTimer.elapsedSeconds();
+    double randomRate = (double)RANDOM_LOOKUPS * PASSES / randomSeconds;
+    
+    long long coherentLookups = 0;
+    BenchTimer coherentTimer;
+    for (int pass = 0; pass < PASSES; pass++) {
+        for (int x = minXZ; x < maxXZ; x++) {
+            for (int z = minXZ; z < maxXZ; z++) {
+                for (int y = 0; y < maxY; y++) {
+                    checksum += world.getBlockAt(x, y, z).type;
+                }
+            }
+        }
+        coherentLookups += (long long)span * span * maxY;
+    }
+    double coherentSeconds = coherentTimer.elapsedSeconds();
+    double coherentRate = coherentLookups / coherentSeconds;
+    
+    benchConsume(checksum);
+    std::cout << "Random lookups:   " << randomRate / 1e6 << " M/s" << std::endl;
+    std::cout << "Coherent lookups: " << coherentRate / 1e6 << " M/s" << std::endl;
+}
@@ -0,0 +1,60 @@
+#include "Bench.h"
+#include "World.h"
+#include "Random.h"
+#include "Collision.h"
+#include <iostream>
+#include <vector>
+
+// VoxelCollider::move throughput for a player-sized box near the spawn terrain,
+// for a walking step, a step at terminal fall speed, and a long sweep that
+// crosses dozens of voxels in one call
+void benchCollision() {
+    const int BOXES = 100000;
+    const int PASSES = 10;
+    const float STEP = 1.0f / 60.0f;
+    
+    World world(DEFAULT_WORLD_SEED);
+    world.generateWorld();
+    VoxelCollider collider(world);
+    
+    const int minXZ = -SPAWN_RADIUS * CHUNK_WIDTH / 2;
+    const int span = SPAWN_RADIUS * CHUNK_WIDTH;
+    
+    // Boxes standing just above the surface, so most moves end on the ground
+    std::vector<AABB> boxes(BOXES);
+    CounterRandom rng(12345);
+    for (AABB& box : boxes) {
+        float x = minXZ + rng.nextFloat() * span;
+        float z = minXZ + rng.nextFloat() * span;
+        float y = world.getSurfaceHeight((int)x, (int)z) + 1.0f + rng.nextFloat() * 0.5f;
+        box = AABB::standingAt(Vector3(x, y, z), 0.3f, 1.9f);
+    }
+    
+    struct Case {
+        const char* name;
+        Vector3 velocity;
+    };
+    const Case CASES[] = {
+        { "Walking:  ", Vector3(6.0f, -8.0f, 3.0f) },
+        { "Terminal: ", Vector3(0.0f, -50.0f, 0.0f) },
+        { "Long:     ", Vector3(600.0f, -1800.0f, -300.0f) },
+    };
+    
+    for (const Case& c : CASES) {
+        Vector3 motion = c.velocity * STEP;
+        uint64_t hits = 0;
+        BenchTimer timer;
+        for (int pass = 0; pass < PASSES; pass++) {
+            for (const AABB& start : boxes) {
+                AABB box = start;
+                CollisionResult result = collider.move(box, motion);
+                hits += result.hit[0] + result.hit[1] + result.hit[2];
+            }
+        }
+        double seconds = timer.elapsedSeconds();
+        
+        benchConsume(hits);
+        std::cout << c.name << (double)BOXES * PASSES / seconds << " resolves/s, "
+                  << (double)hits / PASSES / BOXES << " axes blocked per resolve" << std::endl;
+    }
+}
@@ -0,0 +1,47 @@
+#include "Bench.h"
+#include "World.h"
+#include "ChunkMesher.h"
+#include <iostream>
+#include <vector>
+#include <memory>
+
+// ChunkMesher::buildMesh throughput over the spawn chunks, with per-vertex
+// ambient occlusion baked and without
+void benchMeshing() {
+    const int PASSES = 20;
+    
+    World world(DEFAULT_WORLD_SEED);
+    world.generateWorld();
+    
+    // Snapshots are taken once, so only meshing itself is timed
+    std::vector<std::unique_ptr<ChunkSnapshot>> snapshots;
+    for (int x = -SPAWN_RADIUS; x <= SPAWN_RADIUS; x++) {
+        for (int z = -SPAWN_RADIUS; z <= SPAWN_RADIUS; z++) {
+            for (int y = 0; y < WORLD_HEIGHT; y++) {
+                Chunk* chunk = world.getChunkAt(x, y, z);
+                if (chunk && !chunk->isEmpty()) {
+                    snapshots.push_back(ChunkSnapshot::capture(*chunk));
+                }
+            }
+        }
+    }
+    
+    ChunkMeshData mesh;
+    for (bool ambientOcclusion : { false, true }) {
+        uint64_t vertices = 0;
+        BenchTimer timer;
+        for (int pass = 0; pass < PASSES; pass++) {
+            for (std::unique_ptr<ChunkSnapshot>& snapshot : snapshots) {
+                snapshot->ambientOcclusion = ambientOcclusion;
+                ChunkMesher::buildMesh(*snapshot, mesh);
+                vertices += mesh.vertices.size();
+            }
+        }
+        double seconds = timer.elapsedSeconds();
+        double chunksPerSecond = (double)snapshots.size() * PASSES / seconds;
+        
+        benchConsume(vertices);
+        std::cout << (ambientOcclusion ? "With AO:    " : "Without AO: ") << chunksPerSecond << " chunks/s, "
+                  << vertices / PASSES / snapshots.size() << " vertices per chunk" << std::endl;
+    }
+}
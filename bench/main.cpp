@@ -0,0 +1,45 @@
+#include "Bench.h"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+namespace {
+
+struct BenchEntry {
+    const char* name;
+    void (*run)();
+};
+
+const BenchEntry BENCHMARKS[] = {
+    { "lookups", benchBlockLookups },
+    { "meshing", benchMeshing },
+    { "collision", benchCollision },
+};
+
+} // namespace
+
+// Usage: mycraft_bench [name...]   (no names runs everything)
+int main(int argc, char** argv) {
+    bool ranAny = false;
+    for (const BenchEntry& bench : BENCHMARKS) {
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], bench.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+        
+        std::cout << "== " << bench.name << " ==" << std::endl;
+        bench.run();
+        ranAny = true;
+    }
+    
+    if (!ranAny) {
+        std::cout << "Unknown benchmark. Available:";
+        for (const BenchEntry& bench : BENCHMARKS) {
+            std::cout << " " << bench.name;
+        }
+        std::cout << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,11 +1,10 @@
 #ifndef BLOCK_H
 #define BLOCK_H
 
+#include <cstdint>
 #include <string>
-#include <vector>
-#include "Vector3.h"
 
-enum BlockType {
+enum BlockType : uint8_t {
     AIR,
     GRASS,
     DIRT,
@@ -19,45 +18,64 @@ enum BlockType {
     DIAMOND_ORE
 };
 
+const int BLOCK_TYPE_COUNT = DIAMOND_ORE + 1;
+
+// Render pass a block type's faces are drawn in
+enum class RenderLayer : uint8_t {
+    SOLID,       // Depth-written, no blending
+    TRANSLUCENT  // Blended back to front without depth writes, e.g. water
+};
+
+const int RENDER_LAYER_COUNT = 2;
+
+// Per-type block properties, kept in a side table so a stored block is just its 1-byte ID
+struct BlockProperties {
+    const char* name;
+    bool solid;
+    RenderLayer layer;
+    uint8_t lightOpacity;  // Light levels lost passing through, on top of the usual 1 per block; 15 blocks it
+    uint8_t lightEmission; // Block light level the block gives off
+    float color[3]; // Flat colour used by the SOLID render mode
+};
+
+inline constexpr BlockProperties BLOCK_PROPERTIES[BLOCK_TYPE_COUNT] = {
+    { "Air",         false, RenderLayer::SOLID,        0, 0, { 0.8f, 0.8f, 0.8f } }, // AIR
+    { "Grass",       true,  RenderLayer::SOLID,       15, 0, { 0.2f, 0.8f, 0.2f } }, // GRASS - Bright Green
+    { "Dirt",        true,  RenderLayer::SOLID,       15, 0, { 0.6f, 0.4f, 0.2f } }, // DIRT - Brown
+    { "Stone",       true,  RenderLayer::SOLID,       15, 0, { 0.6f, 0.6f, 0.6f } }, // STONE - Gray
+    { "Wood",        true,  RenderLayer::SOLID,       15, 0, { 0.6f, 0.3f, 0.1f } }, // WOOD - Dark Brown
+    { "Leaves",      false, RenderLayer::SOLID,        1, 0, { 0.1f, 0.6f, 0.1f } }, // LEAVES - Dark Green
+    { "Water",       false, RenderLayer::TRANSLUCENT,  2, 0, { 0.2f, 0.4f, 0.8f } }, // WATER - Blue
+    { "Sand",        true,  RenderLayer::SOLID,       15, 0, { 0.9f, 0.8f, 0.6f } }, // SAND - Sandy Yellow
+    { "Coal Ore",    true,  RenderLayer::SOLID,       15, 0, { 0.3f, 0.3f, 0.3f } }, // COAL_ORE - Dark Gray
+    { "Iron Ore",    true,  RenderLayer::SOLID,       15, 0, { 0.8f, 0.7f, 0.6f } }, // IRON_ORE - Beige
+    { "Diamond Ore", true,  RenderLayer::SOLID,       15, 0, { 0.7f, 0.9f, 0.9f } }  // DIAMOND_ORE - Light Blue
+};
+
+inline const BlockProperties& getBlockProperties(BlockType type) {
+    return BLOCK_PROPERTIES[type < BLOCK_TYPE_COUNT ? type : AIR];
+}
+
 struct Block {
     BlockType type;
-    Vector3 position;
-    
-    Block() : type(AIR), position(Vector3(0, 0, 0)) {}
-    Block(BlockType t) : type(t), position(Vector3(0, 0, 0)) {}
-    Block(BlockType t, Vector3 pos) : type(t), position(pos) {}
-    
+
+    Block() : type(AIR) {}
+    Block(BlockType t) : type(t) {}
+
     bool isSolid() const {
-        switch(type) {
-            case AIR:
-            case WATER:
-            case LEAVES:
-                return false;
-            default:
-                return true;
-        }
+        return getBlockProperties(type).solid;
     }
-    
+
     bool isEmpty() const {
         return type == AIR;
     }
-    
+
     std::string toString() const {
-        switch(type) {
-            case AIR: return "Air";
-            case GRASS: return "Grass";
-            case DIRT: return "Dirt";
-            case STONE: return "Stone";
-            case WOOD: return "Wood";
-            case LEAVES: return "Leaves";
-            case WATER: return "Water";
-            case SAND: return "Sand";
-            case COAL_ORE: return "Coal Ore";
-            case IRON_ORE: return "Iron Ore";
-            case DIAMOND_ORE: return "Diamond Ore";
-            default: return "Unknown";
-        }
+        if (type >= BLOCK_TYPE_COUNT) return "Unknown";
+        return getBlockProperties(type).name;
     }
 };
 
+static_assert(sizeof(Block) == 1, "Block must stay a 1-byte ID");
+
 #endif // BLOCK_H
@@ -3,30 +3,184 @@
 
 #include <vector>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include "Block.h"
 #include "Vector3.h"
+#include "PalettedContainer.h"
 
 const int CHUNK_WIDTH = 16;
 const int CHUNK_HEIGHT = 128;
 const int CHUNK_DEPTH = 16;
+const int CHUNK_VOLUME = CHUNK_WIDTH * CHUNK_HEIGHT * CHUNK_DEPTH;
+const int CHUNK_SECTIONS = CHUNK_HEIGHT / SECTION_SIZE;
+
+// Face directions shared by meshing and visibility:
+// 0=front(-z), 1=back(+z), 2=top(+y), 3=bottom(-y), 4=right(+x), 5=left(-x)
+const int FACE_COUNT = 6;
+const int FACE_DIRECTIONS[FACE_COUNT][3] = {
+    { 0, 0, -1 }, { 0, 0, 1 }, { 0, 1, 0 }, { 0, -1, 0 }, { 1, 0, 0 }, { -1, 0, 0 }
+};
+
+inline int oppositeFace(int face) { return face ^ 1; }
+
+// Chunk dimensions are powers of two so block addressing is a shift and a mask
+const int CHUNK_WIDTH_SHIFT = 4;
+const int CHUNK_HEIGHT_SHIFT = 7;
+const int CHUNK_DEPTH_SHIFT = 4;
+static_assert(CHUNK_WIDTH == 1 << CHUNK_WIDTH_SHIFT, "CHUNK_WIDTH must be a power of two");
+static_assert(CHUNK_HEIGHT == 1 << CHUNK_HEIGHT_SHIFT, "CHUNK_HEIGHT must be a power of two");
+static_assert(CHUNK_DEPTH == 1 << CHUNK_DEPTH_SHIFT, "CHUNK_DEPTH must be a power of two");
+static_assert(SECTION_SIZE == 1 << SECTION_SHIFT, "SECTION_SIZE must be a power of two");
+
+// Split a world block coordinate into the chunk index containing it and the
+// offset inside that chunk. The arithmetic shift rounds toward negative infinity
+// and the mask wraps into [0, size), so e.g. x = -1 is block 15 of chunk -1.
+inline int blockToChunkX(int x) { return x >> CHUNK_WIDTH_SHIFT; }
+inline int blockToChunkY(int y) { return y >> CHUNK_HEIGHT_SHIFT; }
+inline int blockToChunkZ(int z) { return z >> CHUNK_DEPTH_SHIFT; }
+inline int blockToLocalX(int x) { return x & (CHUNK_WIDTH - 1); }
+inline int blockToLocalY(int y) { return y & (CHUNK_HEIGHT - 1); }
+inline int blockToLocalZ(int z) { return z & (CHUNK_DEPTH - 1); }
+
+// One bit per cell of a chunk column, bit y of word y / 64
+const int COLUMN_WORDS = CHUNK_HEIGHT / 64;
+static_assert(CHUNK_HEIGHT % 64 == 0, "CHUNK_HEIGHT must be a multiple of 64");
+
+struct ColumnMask {
+    uint64_t words[COLUMN_WORDS];
+    
+    bool test(int y) const { return (words[y >> 6] >> (y & 63)) & 1; }
+    void set(int y) { words[y >> 6] |= 1ull << (y & 63); }
+    void reset(int y) { words[y >> 6] &= ~(1ull << (y & 63)); }
+    
+    bool any() const {
+        uint64_t bits = 0;
+        for (int w = 0; w < COLUMN_WORDS; w++) bits |= words[w];
+        return bits != 0;
+    }
+    // Highest set bit, or -1 if the column is empty
+    int highest() const {
+        for (int w = COLUMN_WORDS - 1; w >= 0; w--) {
+            if (words[w]) return w * 64 + 63 - __builtin_clzll(words[w]);
+        }
+        return -1;
+    }
+    int count() const {
+        int total = 0;
+        for (int w = 0; w < COLUMN_WORDS; w++) {
+            total += __builtin_popcountll(words[w]);
+        }
+        return total;
+    }
+};
+
+// Light is stored as one byte per cell: sky light in the high nibble, block
+// light in the low, each 0 (dark) to MAX_LIGHT
+const int MAX_LIGHT = 15;
+const uint8_t SKY_LIGHT_SHIFT = 4;
+const uint8_t FULL_SKY_LIGHT = MAX_LIGHT << SKY_LIGHT_SHIFT;
+
+inline int getSkyLight(uint8_t light) { return light >> SKY_LIGHT_SHIFT; }
+inline int getBlockLight(uint8_t light) { return light & MAX_LIGHT; }
+
+// Integer chunk index (not world block coordinates)
+struct ChunkCoord {
+    int x, y, z;
+    
+    bool operator==(const ChunkCoord& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+    bool operator!=(const ChunkCoord& other) const { return !(*this == other); }
+};
+
+struct ChunkCoordHash {
+    size_t operator()(const ChunkCoord& c) const {
+        size_t h = std::hash<int>()(c.x);
+        h = h * 31 + std::hash<int>()(c.y);
+        h = h * 31 + std::hash<int>()(c.z);
+        return h;
+    }
+};
 
 class Chunk {
 private:
-    std::vector<std::vector<std::vector<Block>>> blocks;
+    // Vertical stack of palette-compressed 16x16x16 sections; a null section is all air
+    std::unique_ptr<PalettedContainer> sections[CHUNK_SECTIONS];
     Vector3 position;
-    
+    uint32_t revision; // Bumped on every change so cached meshes know to rebuild
+    Chunk* neighbours[FACE_COUNT]; // Loaded chunk across each face, maintained by World
+    // Opaque (solid) cells of each x/z column, kept in step by setBlock; null
+    // until the chunk holds its first solid block
+    std::unique_ptr<ColumnMask[]> opaqueColumns;
+    // Light per section, in PalettedContainer cell order; a null section is
+    // uniformly lit at uniformLight. Written only by the LightEngine.
+    std::unique_ptr<uint8_t[]> lightSections[CHUNK_SECTIONS];
+    uint8_t uniformLight[CHUNK_SECTIONS];
+
 public:
     Chunk(Vector3 pos);
     ~Chunk();
     
-    Block& getBlock(int x, int y, int z);
+    static bool inBounds(int x, int y, int z) {
+        return x >= 0 && x < CHUNK_WIDTH &&
+               y >= 0 && y < CHUNK_HEIGHT &&
+               z >= 0 && z < CHUNK_DEPTH;
+    }
+    
+    Block getBlock(int x, int y, int z) const;
+    // getBlock() for coordinates the caller already knows are inside the chunk
+    Block getBlockUnchecked(int x, int y, int z) const {
+        const PalettedContainer* section = sections[y >> SECTION_SHIFT].get();
+        if (!section) return Block();
+        return Block(section->get(PalettedContainer::cellIndex(x, y & (SECTION_SIZE - 1), z)));
+    }
     void setBlock(int x, int y, int z, Block block);
     
     Vector3 getPosition() const { return position; }
     void setPosition(Vector3 pos) { position = pos; }
+    ChunkCoord getCoord() const { return { (int)position.x, (int)position.y, (int)position.z }; }
     
-    bool isBlockSolid(int x, int y, int z) const;
+    // Adjacent chunk in a face direction, or null if it isn't loaded
+    Chunk* getNeighbour(int face) const { return neighbours[face]; }
+    void setNeighbour(int face, Chunk* chunk) { neighbours[face] = chunk; }
+    
+    uint32_t getRevision() const { return revision; }
+    // Invalidate derived data, e.g. when a neighbouring chunk's border changes
+    void markDirty() { revision++; }
+    
+    bool isBlockSolid(int x, int y, int z) const {
+        return inBounds(x, y, z) && opaqueColumns && opaqueColumns[x * CHUNK_DEPTH + z].test(y);
+    }
+    // Opaque cells of the column at (x, z) as a bitmask over y
+    ColumnMask getOpaqueColumn(int x, int z) const {
+        if (opaqueColumns) return opaqueColumns[x * CHUNK_DEPTH + z];
+        return ColumnMask();
+    }
     bool isBlockEmpty(int x, int y, int z) const;
+    
+    // Packed sky and block light of a cell inside the chunk
+    uint8_t getLight(int x, int y, int z) const {
+        const uint8_t* section = lightSections[y >> SECTION_SHIFT].get();
+        if (!section) return uniformLight[y >> SECTION_SHIFT];
+        return section[PalettedContainer::cellIndex(x, y & (SECTION_SIZE - 1), z)];
+    }
+    void setLight(int x, int y, int z, uint8_t light);
+    // Light a whole section evenly, dropping its per-cell storage
+    void fillSectionLight(int index, uint8_t light);
+    
+    // Section-level queries so callers can skip all-air space in 16-block steps
+    const PalettedContainer* getSection(int index) const { return sections[index].get(); }
+    bool isSectionEmpty(int index) const { return !sections[index]; }
+    bool isEmpty() const;
+    
+    // Highest solid block in a column, or -1 if the column is empty
+    int getHighestSolidY(int x, int z) const;
+    
+    // Repack every section at its narrowest palette width (e.g. after generation)
+    void compact();
+    size_t memoryUsage() const;
 };
 
 #endif // CHUNK_H
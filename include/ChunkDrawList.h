@@ -0,0 +1,54 @@
+#ifndef CHUNKDRAWLIST_H
+#define CHUNKDRAWLIST_H
+
+#include <GL/gl.h>
+#include <vector>
+#include "GeometryArena.h"
+#include "Vector3.h"
+
+// The chunk meshes to draw this frame, as ranges of the geometry arena, sent to
+// GL together once the visibility passes are done. With multi-draw indirect
+// (GL 4.3) the whole list is a single call: each command's base instance
+// selects its chunk origin from an instanced attribute. Otherwise the arena
+// buffer is still bound only once and each range is one glDrawArrays, with the
+// origin set as a constant attribute in between.
+class ChunkDrawList {
+private:
+    // Layout fixed by GL for glMultiDrawArraysIndirect
+    struct DrawArraysIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint first;
+        GLuint baseInstance;
+    };
+    
+    std::vector<DrawArraysIndirectCommand> commands;
+    std::vector<GLfloat> origins; // x, y, z per command
+    bool indirect;
+    GLuint commandBuffer;
+    GLuint originBuffer;
+    int lastDrawCalls;
+
+public:
+    ChunkDrawList();
+    ~ChunkDrawList();
+    
+    ChunkDrawList(const ChunkDrawList&) = delete;
+    ChunkDrawList& operator=(const ChunkDrawList&) = delete;
+    
+    // Pick the submission path the context supports; needs a current GL context
+    void init();
+    
+    void clear();
+    void add(GLint first, GLsizei count, const Vector3& origin);
+    bool isEmpty() const { return commands.empty(); }
+    
+    // Draw everything added since clear(). Expects the chunk shader bound and its
+    // position and info attribute arrays enabled.
+    void submit(const GeometryArena& arena);
+    
+    bool usesIndirect() const { return indirect; }
+    int getLastDrawCalls() const { return lastDrawCalls; }
+};
+
+#endif // CHUNKDRAWLIST_H
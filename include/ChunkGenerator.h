@@ -0,0 +1,73 @@
+#ifndef CHUNKGENERATOR_H
+#define CHUNKGENERATOR_H
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <unordered_set>
+#include "Chunk.h"
+#include "MpscQueue.h"
+
+// A column the world wants generated; lower priority values are generated first
+struct ColumnJob {
+    ChunkCoord column; // y is always 0
+    float priority;
+};
+
+// A fully generated column waiting to be moved into the world
+struct GeneratedColumn {
+    ChunkCoord column;
+    std::vector<std::shared_ptr<Chunk>> chunks; // Bottom to top
+    
+    GeneratedColumn() : column{ 0, 0, 0 } {}
+};
+
+// Worker threads that generate chunk columns in priority order. The world
+// replaces the whole list of waiting jobs whenever its priorities change, which
+// also cancels columns it no longer wants; jobs already started always finish.
+// Finished columns are published through a lock-free queue.
+class ChunkGenerator {
+public:
+    // Fills in one freshly constructed chunk; called concurrently from every worker
+    typedef std::function<void(Chunk&)> GenerateFunction;
+
+private:
+    GenerateFunction generate;
+    int columnHeight;
+    std::vector<std::thread> workers;
+    mutable std::mutex jobMutex;
+    std::condition_variable jobAvailable;
+    std::vector<ColumnJob> jobs; // Sorted worst-first so the best job pops off the back
+    std::unordered_set<ChunkCoord, ChunkCoordHash> activeColumns; // Started, or finished but not yet polled
+    bool stopping;
+    
+    MpscQueue<GeneratedColumn> results;
+    std::atomic<int> jobsCancelled;
+    
+    void workerLoop();
+
+public:
+    // threadCount <= 0 picks one thread per spare hardware core
+    ChunkGenerator(GenerateFunction generate, int columnHeight, int threadCount = 0);
+    ~ChunkGenerator();
+    
+    ChunkGenerator(const ChunkGenerator&) = delete;
+    ChunkGenerator& operator=(const ChunkGenerator&) = delete;
+    
+    // Replace every job that hasn't started yet. Columns that were waiting and are
+    // not in the new list are cancelled; columns already being generated are skipped.
+    void schedule(std::vector<ColumnJob> newJobs);
+    
+    // Main thread only: take one finished column if any is ready
+    bool pollResult(GeneratedColumn& out);
+    
+    int getJobsQueued() const;
+    int getJobsCancelled() const { return jobsCancelled.load(std::memory_order_relaxed); }
+    int getThreadCount() const { return (int)workers.size(); }
+};
+
+#endif // CHUNKGENERATOR_H
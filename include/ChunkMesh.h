@@ -0,0 +1,57 @@
+#ifndef CHUNKMESH_H
+#define CHUNKMESH_H
+
+#include <GL/gl.h>
+#include <cstdint>
+#include "ChunkMesher.h"
+#include "GeometryArena.h"
+#include "Vector3.h"
+
+// A chunk's mesh on the GPU: a range of the shared geometry arena, replaced only
+// when the chunk's revision changes
+class ChunkMesh {
+private:
+    GeometryArena* arena;
+    int arenaHandle;
+    GLsizei vertexCount;
+    uint32_t layerStart[RENDER_LAYER_COUNT + 1]; // Offsets within the mesh's arena range
+    uint32_t revision;
+    int lod;
+    bool built;
+    Vector3 boundsMin, boundsMax; // Chunk-relative extent of the geometry
+    uint64_t faceConnectivity;
+
+public:
+    ChunkMesh();
+    ~ChunkMesh();
+    
+    ChunkMesh(const ChunkMesh&) = delete;
+    ChunkMesh& operator=(const ChunkMesh&) = delete;
+    
+    void upload(const ChunkMeshData& data, uint32_t chunkRevision, GeometryArena& geometryArena);
+    void release();
+    
+    bool isBuilt() const { return built; }
+    bool isEmpty() const { return vertexCount == 0; }
+    Vector3 getBoundsMin() const { return boundsMin; }
+    Vector3 getBoundsMax() const { return boundsMax; }
+    
+    // Whether the chunk's interior lets faces a and b see each other; unbuilt
+    // meshes are treated as fully open
+    bool facesConnected(int a, int b) const {
+        return !built || (faceConnectivity & ChunkMesher::faceConnectionBit(a, b)) != 0;
+    }
+    uint32_t getRevision() const { return revision; }
+    int getLod() const { return lod; }
+    GLsizei getVertexCount() const { return vertexCount; }
+    // A render layer's vertices. The range moves when the arena defragments, so
+    // look it up each frame.
+    GLint getLayerFirst(RenderLayer layer) const {
+        return arena->getFirst(arenaHandle) + (GLint)layerStart[(int)layer];
+    }
+    GLsizei getLayerCount(RenderLayer layer) const {
+        return (GLsizei)(layerStart[(int)layer + 1] - layerStart[(int)layer]);
+    }
+};
+
+#endif // CHUNKMESH_H
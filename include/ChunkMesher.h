@@ -0,0 +1,124 @@
+#ifndef CHUNKMESHER_H
+#define CHUNKMESHER_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include "Block.h"
+#include "Chunk.h"
+
+// Snapshot dimensions: the chunk plus one layer on every side holding the
+// touching blocks of all 26 surrounding chunks
+const int PADDED_WIDTH = CHUNK_WIDTH + 2;
+const int PADDED_HEIGHT = CHUNK_HEIGHT + 2;
+const int PADDED_DEPTH = CHUNK_DEPTH + 2;
+const int PADDED_VOLUME = PADDED_WIDTH * PADDED_HEIGHT * PADDED_DEPTH;
+
+// Packed 8-byte vertex for chunk geometry. Positions are corners relative to the
+// chunk origin, which the renderer supplies per draw; y reaches CHUNK_HEIGHT, so
+// every field fits a byte. Texture coordinates are not stored: the shader derives
+// them from the position and face, repeating the tile once per block across
+// merged faces.
+struct ChunkVertex {
+    uint8_t x, y, z;
+    uint8_t tile;  // Atlas tile index (the block type)
+    uint8_t face;  // Face direction 0-5, see FACE_DIRECTIONS
+    uint8_t ao;    // Ambient occlusion, 0 (darkest) to AO_LEVELS - 1 (open)
+    uint8_t light; // Sky light in the high nibble, block light in the low
+    uint8_t reserved;
+    
+    static const int AO_LEVELS = 4;
+    static const uint8_t FULL_LIGHT = FULL_SKY_LIGHT; // Full skylight, no block light
+};
+
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+static_assert(CHUNK_WIDTH <= 255 && CHUNK_HEIGHT <= 255 && CHUNK_DEPTH <= 255,
+              "Chunk-local corner positions must fit ChunkVertex's bytes");
+
+// CPU-side mesh for one chunk, ready to be uploaded into a vertex buffer
+struct ChunkMeshData {
+    std::vector<ChunkVertex> vertices; // GL_QUADS, four vertices per face, grouped by render layer
+    uint32_t layerStart[RENDER_LAYER_COUNT + 1]; // Layer l is vertices [layerStart[l], layerStart[l + 1])
+    uint64_t faceConnectivity;         // See ChunkMesher::faceConnectionBit
+    int lod;                           // Level of detail the mesh was built at
+    
+    ChunkMeshData() : layerStart(), faceConnectivity(0), lod(0) {}
+    void clear() {
+        vertices.clear();
+        std::fill_n(layerStart, RENDER_LAYER_COUNT + 1, 0);
+        faceConnectivity = 0;
+        lod = 0;
+    }
+};
+
+// Immutable copy of everything meshing a chunk needs: its blocks decoded into a
+// dense array padded with the neighbouring chunks' border layer, so looking one
+// block past the edge is the same array access as looking inside. Taken on the
+// main thread so mesh workers never read live world data.
+struct ChunkSnapshot {
+    ChunkCoord coord;
+    uint32_t revision;
+    int lod;        // Level of detail to mesh at, see ChunkMesher::MAX_LOD
+    bool ambientOcclusion; // Bake per-vertex ambient occlusion (full-detail meshes only)
+    int minY, maxY; // Span of non-empty sections, [minY, maxY)
+    
+    std::vector<BlockType> blocks; // PADDED_VOLUME, same (x, z, y) order as Chunk
+    std::vector<ColumnMask> present; // Non-air cells of each column, by x * CHUNK_DEPTH + z
+    std::vector<ColumnMask> opaque;  // Opaque cells of each padded column, by columnIndex
+    std::vector<uint8_t> light;      // PADDED_VOLUME packed sky and block light; full skylight where unloaded
+    
+    // Reads the chunk and, through its neighbour links, the layer around it (air where nothing is loaded)
+    static std::unique_ptr<ChunkSnapshot> capture(const Chunk& chunk, int lod = 0);
+    
+    // Index of chunk-local coordinates, each in [-1, size]
+    static int paddedIndex(int x, int y, int z) {
+        return ((x + 1) * PADDED_DEPTH + (z + 1)) * PADDED_HEIGHT + (y + 1);
+    }
+    // Index of a padded column, x and z each in [-1, size]
+    static int columnIndex(int x, int z) {
+        return (x + 1) * PADDED_DEPTH + (z + 1);
+    }
+    // Index step to the adjacent cell in a face direction
+    static int faceOffset(int face) {
+        return (FACE_DIRECTIONS[face][0] * PADDED_DEPTH + FACE_DIRECTIONS[face][2]) * PADDED_HEIGHT +
+               FACE_DIRECTIONS[face][1];
+    }
+    
+    // Block at chunk-local coordinates, reaching one block into the neighbours
+    BlockType getBlock(int x, int y, int z) const { return blocks[paddedIndex(x, y, z)]; }
+};
+
+class ChunkMesher {
+public:
+    // Texture atlas layout: 64x64 block tiles in a 512x512 atlas, indexed by BlockType
+    static const int ATLAS_TILES_PER_ROW = 8;
+    
+    // Top-left UV and UV size of a block type's tile in the atlas
+    static void getTileUV(BlockType type, float& u, float& v, float& size);
+    
+    // Directions whose dot product with a position gives a face's texture u and v
+    // in block units, matching the orientation emitted quads had with stored UVs
+    static void getFaceTextureAxes(int face, int uAxis[3], int vAxis[3]);
+    
+    // Chunk visibility graph: bit (a * 6 + b) is set when face a can see face b
+    // through connected non-solid blocks inside the chunk
+    static const uint64_t ALL_FACES_CONNECTED = (1ull << (FACE_COUNT * FACE_COUNT)) - 1;
+    static uint64_t faceConnectionBit(int a, int b) { return 1ull << (a * FACE_COUNT + b); }
+    static uint64_t computeFaceConnectivity(const ChunkSnapshot& snapshot);
+    
+    // Levels of detail: level n meshes the chunk as a grid of (1 << n)-block
+    // cells, each taking the majority occupancy of the blocks it covers
+    static constexpr int MAX_LOD = 3;
+    
+    // Build the visible faces of a chunk, greedily merging coplanar faces of the
+    // same block type, light and corner occlusion into larger quads, along with
+    // its face connectivity. Each face takes the light of the cell in front of it;
+    // each corner is darkened by the opaque blocks around it in that layer.
+    // Coarse levels close the seams with full-detail neighbours themselves, so a
+    // chunk's mesh never depends on the level its neighbours are drawn at.
+    // Safe to call from any thread.
+    static void buildMesh(const ChunkSnapshot& snapshot, ChunkMeshData& out);
+};
+
+#endif // CHUNKMESHER_H
@@ -0,0 +1,50 @@
+#ifndef CHUNKSHADER_H
+#define CHUNKSHADER_H
+
+#include <GL/gl.h>
+#include "Block.h"
+
+// How the fragment stage colours chunk faces
+enum class ChunkShading {
+    TEXTURED,    // Atlas tile
+    BLOCK_COLOR, // Flat per-type colour from BLOCK_PROPERTIES
+    WHITE        // Wireframe
+};
+
+// GLSL program for chunk meshes. The vertex stage unpacks ChunkVertex: it adds
+// the chunk origin attribute to the byte position and derives block-unit UVs from
+// the position and face. Greedy-merged quads span several blocks, so the fragment
+// stage wraps those UVs inside the block's atlas tile (fixed-function GL_REPEAT
+// would repeat the whole atlas instead).
+class ChunkShader {
+private:
+    GLuint program;
+    GLint atlasLocation;
+    GLint tilesPerRowLocation;
+    GLint shadingLocation;
+    GLint layerAlphaLocation;
+    
+    static GLuint compileShader(GLenum type, const char* source);
+
+public:
+    // Generic attribute slots: ChunkVertex's (x, y, z, tile) and (face, ao, light, -),
+    // and the world position of the chunk being drawn
+    static const GLuint POSITION_ATTRIBUTE = 0;
+    static const GLuint INFO_ATTRIBUTE = 1;
+    static const GLuint ORIGIN_ATTRIBUTE = 2;
+    
+    ChunkShader();
+    ~ChunkShader();
+    
+    // Compile and link; returns false (and logs why) if GLSL is unavailable
+    bool init(int atlasTilesPerRow);
+    
+    // Binding starts in the solid layer
+    void bind(GLuint atlasTexture, ChunkShading shading) const;
+    void unbind() const;
+    
+    // Blend alpha for the pass about to be drawn; call while bound
+    void setLayer(RenderLayer layer) const;
+};
+
+#endif // CHUNKSHADER_H
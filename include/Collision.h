@@ -0,0 +1,49 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "Vector3.h"
+
+class World;
+
+// Axis-aligned box in world coordinates
+struct AABB {
+    float min[3];
+    float max[3];
+    
+    // Box standing on base: halfWidth either side of it in x and z, height up in y
+    static AABB standingAt(const Vector3& base, float halfWidth, float height);
+    
+    void translate(int axis, float distance) {
+        min[axis] += distance;
+        max[axis] += distance;
+    }
+};
+
+struct CollisionResult {
+    Vector3 motion;  // How far the box actually moved
+    bool hit[3];     // Whether movement along each axis was cut short
+};
+
+// Moves boxes through the world, stopping them against solid blocks. Each axis
+// is swept on its own (y first, then x, then z) and only the voxels the box's
+// leading face passes through are looked at, one slab at a time, stopping at
+// the first slab with a solid block in it; no step is ever skipped, however far
+// the box moves. Blocks the box already overlaps are ignored so an entity stuck
+// in a block can still move out of it. Unloaded space is empty, as in
+// World::isBlockSolidAt. Not tied to the player: anything with a box can use it.
+class VoxelCollider {
+private:
+    World& world;
+    
+    bool isSlabSolid(const AABB& box, int axis, int cell) const;
+
+public:
+    explicit VoxelCollider(World& world) : world(world) {}
+    
+    // Farthest the box can move along one axis (sign gives the direction), up to distance
+    float sweepAxis(const AABB& box, int axis, float distance) const;
+    // Move the box by motion, cut short wherever it would enter a solid block
+    CollisionResult move(AABB& box, const Vector3& motion) const;
+};
+
+#endif // COLLISION_H
@@ -0,0 +1,99 @@
+#ifndef FLUIDSIMULATOR_H
+#define FLUIDSIMULATOR_H
+
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include "Block.h"
+
+class World;
+
+// World block coordinate
+struct BlockPos {
+    int x, y, z;
+    
+    bool operator==(const BlockPos& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+struct BlockPosHash {
+    size_t operator()(const BlockPos& p) const {
+        size_t h = std::hash<int>()(p.x);
+        h = h * 31 + std::hash<int>()(p.y);
+        h = h * 31 + std::hash<int>()(p.z);
+        return h;
+    }
+};
+
+// Flowing water. Generated and placed water are sources and never change on
+// their own; water that has flowed out of them carries a level counting up with
+// distance from the source, or FALLING when fed from above. Nothing is scanned:
+// only cells whose neighbourhood changed are scheduled, each a fixed number of
+// ticks ahead, so still water costs nothing however much of it is loaded.
+// Every cell works out its own level from its neighbours, so the same tick that
+// spreads water also drains it once its source is gone.
+class FluidSimulator {
+private:
+    struct ScheduledTick {
+        uint64_t tick;
+        uint64_t order; // Same-tick entries run first come, first served
+        BlockPos pos;
+        
+        bool operator>(const ScheduledTick& other) const {
+            return tick != other.tick ? tick > other.tick : order > other.order;
+        }
+    };
+    
+    struct Change {
+        BlockPos pos;
+        int current;
+        int desired;
+    };
+    
+    World& world;
+    std::priority_queue<ScheduledTick, std::vector<ScheduledTick>, std::greater<ScheduledTick>> scheduled;
+    std::unordered_set<BlockPos, BlockPosHash> pending; // Cells in scheduled, so each is queued once
+    std::unordered_map<BlockPos, uint8_t, BlockPosHash> flowLevels; // Flowing water; sources have no entry
+    std::vector<Change> changes; // Reused by tick()
+    uint64_t currentTick;
+    uint64_t nextOrder;
+    int lastUpdates;
+    
+    // Level of the water at a cell: SOURCE, 1..MAX_FLOW, FALLING, or NO_WATER
+    int getLevel(const BlockPos& pos);
+    // Level the cell should have given its neighbours
+    int desiredLevel(const BlockPos& pos, int current);
+    void schedule(const BlockPos& pos, int delay);
+    void scheduleAround(const BlockPos& pos, int delay);
+    void apply(const BlockPos& pos, int current, int desired);
+
+public:
+    static const int NO_WATER = -1;
+    static const int SOURCE = 0;
+    static const int MAX_FLOW = 7;     // Water spreads this many blocks sideways from a source
+    static const int FALLING = 8;
+    static const int FLOW_DELAY = 5;   // Ticks between a cell changing and its neighbours following
+    static const int MAX_UPDATES_PER_TICK = 4096; // The rest wait for the next tick
+    
+    explicit FluidSimulator(World& world);
+    
+    // A block was changed from outside the simulation (an edit, not generation):
+    // wake the water around it. Whatever was set there is now a source or not water.
+    void blockChanged(int x, int y, int z);
+    // Run every update due at the next tick
+    void tick();
+    // Forget flow state in chunks that are no longer loaded; their queued
+    // updates are skipped when they come due
+    void dropUnloaded();
+    
+    uint64_t getCurrentTick() const { return currentTick; }
+    size_t getScheduledCount() const { return pending.size(); }
+    size_t getFlowingCount() const { return flowLevels.size(); }
+    int getLastUpdates() const { return lastUpdates; }
+};
+
+#endif // FLUIDSIMULATOR_H
@@ -0,0 +1,42 @@
+#ifndef FREELISTALLOCATOR_H
+#define FREELISTALLOCATOR_H
+
+#include <cstdint>
+#include <map>
+
+// Offset allocator for sub-allocating ranges of one large buffer. Free space is
+// kept as a map of non-adjacent free blocks, so freeing coalesces with the
+// neighbours on either side in O(log n). Units are up to the caller (the
+// geometry arena counts vertices). Knows nothing about the buffer itself.
+class FreeListAllocator {
+private:
+    std::map<uint32_t, uint32_t> freeBlocks; // Offset -> size, never touching each other
+    uint32_t capacity;
+    uint32_t used;
+
+public:
+    static const uint32_t INVALID_OFFSET = UINT32_MAX;
+    
+    explicit FreeListAllocator(uint32_t capacity = 0);
+    
+    // First fit, lowest offset first so live data drifts toward the front.
+    // Returns INVALID_OFFSET when no single free block is large enough.
+    uint32_t allocate(uint32_t size);
+    void free(uint32_t offset, uint32_t size);
+    
+    // Forget every allocation and treat [0, usedPrefix) as allocated, e.g. after
+    // the caller has packed its live ranges to the front of a new buffer
+    void reset(uint32_t newCapacity, uint32_t usedPrefix = 0);
+    
+    uint32_t getCapacity() const { return capacity; }
+    uint32_t getUsed() const { return used; }
+    uint32_t getFree() const { return capacity - used; }
+    int getFreeBlockCount() const { return (int)freeBlocks.size(); }
+    uint32_t getLargestFreeBlock() const;
+    
+    // Share of the free space that is not in the largest block: 0 when free
+    // space is one contiguous block, approaching 1 as it splinters
+    float getFragmentation() const;
+};
+
+#endif // FREELISTALLOCATOR_H
@@ -0,0 +1,22 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "Vector3.h"
+
+// View frustum as six inward-facing planes (ax + by + cz + d >= 0 inside),
+// extracted from the GL projection and modelview matrices
+class Frustum {
+private:
+    float planes[6][4];
+    
+public:
+    Frustum();
+    
+    // Matrices in OpenGL column-major order, as returned by glGetFloatv
+    void extract(const float projection[16], const float modelview[16]);
+    
+    // Conservative test: false only if the box is entirely outside one plane
+    bool intersectsBox(const Vector3& min, const Vector3& max) const;
+};
+
+#endif // FRUSTUM_H
@@ -0,0 +1,57 @@
+#ifndef GEOMETRYARENA_H
+#define GEOMETRYARENA_H
+
+#include <GL/gl.h>
+#include <cstdint>
+#include <vector>
+#include "ChunkMesher.h"
+#include "FreeListAllocator.h"
+
+// One vertex buffer shared by every chunk mesh. Meshes get a range of it from a
+// free-list allocator and refer to it by handle, because defragmenting moves
+// ranges: live ranges are copied, GPU side, packed to the front of a new buffer.
+// The same copy grows the arena when an allocation does not fit.
+class GeometryArena {
+private:
+    struct Range {
+        uint32_t first; // In vertices
+        uint32_t count;
+        bool live;
+    };
+    
+    GLuint buffer;
+    FreeListAllocator allocator;
+    std::vector<Range> ranges; // By handle
+    std::vector<int> freeHandles;
+    int relocationCount;
+    
+    // Copy every live range, in order, to the front of a new buffer of newCapacity vertices
+    void relocate(uint32_t newCapacity);
+
+public:
+    static const uint32_t INITIAL_CAPACITY = 1 << 20; // Vertices (8 MB)
+    static const int INVALID_HANDLE = -1;
+    
+    GeometryArena();
+    ~GeometryArena();
+    
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+    
+    // Copy vertices into a new range; returns its handle
+    int allocate(const std::vector<ChunkVertex>& vertices);
+    void release(int handle);
+    
+    // Pack live ranges together once free space has splintered; call between frames
+    void defragmentIfNeeded();
+    
+    GLuint getBuffer() const { return buffer; }
+    GLint getFirst(int handle) const { return (GLint)ranges[handle].first; }
+    
+    size_t getCapacityBytes() const { return (size_t)allocator.getCapacity() * sizeof(ChunkVertex); }
+    size_t getUsedBytes() const { return (size_t)allocator.getUsed() * sizeof(ChunkVertex); }
+    int getFreeBlockCount() const { return allocator.getFreeBlockCount(); }
+    int getRelocationCount() const { return relocationCount; }
+};
+
+#endif // GEOMETRYARENA_H
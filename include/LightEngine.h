@@ -0,0 +1,47 @@
+#ifndef LIGHTENGINE_H
+#define LIGHTENGINE_H
+
+#include <vector>
+#include <cstdint>
+#include "Block.h"
+#include "Chunk.h"
+
+// Sky and block light for the loaded chunks, spread by breadth-first flood fill
+// through the chunks' neighbour links. Light drops by one per block, plus the
+// block's lightOpacity; full skylight also falls straight down through
+// transparent blocks without losing any. A changed block only relights the
+// cells whose light came through it: a removal pass darkens everything it lit,
+// then an add pass refills that region from the lit cells around its edge.
+// Main thread only.
+class LightEngine {
+private:
+    enum class Channel { SKY, BLOCK };
+    
+    struct LightNode {
+        Chunk* chunk;
+        uint8_t x, y, z;
+        uint8_t level; // Light the cell had, for removal
+    };
+    
+    std::vector<LightNode> addQueue;
+    std::vector<LightNode> removeQueue;
+    
+    static int getLevel(const LightNode& node, Channel channel);
+    static void setLevel(const LightNode& node, Channel channel, int level);
+    // Cell across a face, following chunk links; false if that chunk isn't loaded
+    static bool step(const LightNode& from, int face, LightNode& to);
+    
+    void propagate(Channel channel);
+    void unpropagate(Channel channel);
+    void relight(const LightNode& node, Channel channel, int emission);
+
+public:
+    // Light a newly loaded column of chunks (bottom first) that is already
+    // linked to its neighbours, and spread light both ways across its borders
+    void lightColumn(Chunk* const* column, int height);
+    
+    // Update light after the block at chunk-local (x, y, z) changed type
+    void blockChanged(Chunk* chunk, int x, int y, int z, BlockType oldType, BlockType newType);
+};
+
+#endif // LIGHTENGINE_H
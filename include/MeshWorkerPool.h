@@ -0,0 +1,56 @@
+#ifndef MESHWORKERPOOL_H
+#define MESHWORKERPOOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "ChunkMesher.h"
+#include "MpscQueue.h"
+
+// A finished chunk mesh waiting to be uploaded on the GL thread
+struct MeshResult {
+    ChunkCoord coord;
+    uint32_t revision;
+    ChunkMeshData mesh;
+    
+    MeshResult() : coord{ 0, 0, 0 }, revision(0) {}
+};
+
+// Worker threads that turn chunk snapshots into vertex arrays off the GLUT
+// thread. Finished meshes are published through a lock-free queue that the
+// renderer drains at its own pace.
+class MeshWorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex jobMutex;
+    std::condition_variable jobAvailable;
+    std::deque<std::unique_ptr<ChunkSnapshot>> jobs;
+    bool stopping;
+    
+    MpscQueue<MeshResult> results;
+    std::atomic<int> jobsInFlight;
+    
+    void workerLoop();
+    
+public:
+    // threadCount <= 0 picks one thread per spare hardware core
+    explicit MeshWorkerPool(int threadCount = 0);
+    ~MeshWorkerPool();
+    
+    MeshWorkerPool(const MeshWorkerPool&) = delete;
+    MeshWorkerPool& operator=(const MeshWorkerPool&) = delete;
+    
+    void submit(std::unique_ptr<ChunkSnapshot> snapshot);
+    
+    // Main thread only: take one finished mesh if any is ready
+    bool pollResult(MeshResult& out);
+    
+    int getJobsInFlight() const { return jobsInFlight.load(std::memory_order_relaxed); }
+    int getThreadCount() const { return (int)workers.size(); }
+};
+
+#endif // MESHWORKERPOOL_H
@@ -0,0 +1,59 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Unbounded lock-free multi-producer / single-consumer queue (Vyukov's
+// node-based design). Any thread may push; only one thread may pop. A push
+// that is still in progress can hide later pushes from pop() until it
+// completes, which only delays delivery by a moment.
+template <typename T>
+class MpscQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next;
+        T value;
+        
+        Node() : next(nullptr), value() {}
+        explicit Node(T&& v) : next(nullptr), value(std::move(v)) {}
+    };
+    
+    std::atomic<Node*> head; // Most recently pushed node (producers)
+    Node* tail;              // Already-consumed stub node (consumer)
+    
+public:
+    MpscQueue() {
+        Node* stub = new Node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+    
+    ~MpscQueue() {
+        T discard;
+        while (pop(discard)) {}
+        delete tail;
+    }
+    
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+    
+    bool pop(T& out) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        
+        // The popped node becomes the new stub; its moved-from value dies with it later
+        out = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+
+#endif // MPSCQUEUE_H
@@ -0,0 +1,30 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <cstdint>
+
+// Seeded 2D gradient (Perlin) noise. The permutation table is shuffled from the
+// seed, so the same seed always gives the same field on every platform and thread.
+class Noise {
+private:
+    uint8_t perm[512]; // Shuffled 0..255, repeated so lookups never need wrapping
+    
+    float sampleOctave(float x, float z) const;
+
+public:
+    static const int GRID_SIZE = 16; // Batch evaluation covers one chunk's columns
+    
+    explicit Noise(uint64_t seed);
+    
+    // Fractal sum of octaves, each at lacunarity times the frequency and gain times
+    // the amplitude of the last, normalised back to roughly [-1, 1]
+    float fractal(float x, float z, int octaves, float lacunarity = 2.0f, float gain = 0.5f) const;
+    
+    // fractal() for a GRID_SIZE x GRID_SIZE grid of points originX + i * spacing,
+    // originZ + j * spacing, written to out[i * GRID_SIZE + j]. Evaluated four
+    // points at a time with SSE2 where available; results match fractal().
+    void fractalGrid(float originX, float originZ, float spacing, int octaves, float* out,
+                     float lacunarity = 2.0f, float gain = 0.5f) const;
+};
+
+#endif // NOISE_H
@@ -0,0 +1,73 @@
+#ifndef PALETTEDCONTAINER_H
+#define PALETTEDCONTAINER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Block.h"
+
+const int SECTION_SIZE = 16;
+const int SECTION_SHIFT = 4;
+const int SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+
+// Block storage for one 16x16x16 section: a small palette of the block types
+// present plus one bit-packed palette index (1-8 bits wide) per cell. The index
+// width grows when a new type is introduced and shrinks again once types are
+// removed, so a section costs bits * 512 bytes instead of 4 KB. A section holding
+// a single type uses zero bits and keeps no index storage at all.
+class PalettedContainer {
+private:
+    std::vector<BlockType> palette;
+    std::vector<uint16_t> paletteCounts; // Cells referencing each palette entry (0 = free slot)
+    std::vector<uint64_t> data;
+    int bitsPerEntry;
+    int liveEntries;
+    
+    static int bitsForEntries(int entries);
+    
+    // Inline: this is on the path of every block lookup
+    uint32_t readIndex(int cell) const {
+        if (bitsPerEntry == 0) return 0;
+        
+        const uint64_t mask = (1ull << bitsPerEntry) - 1;
+        int bit = cell * bitsPerEntry;
+        int word = bit >> 6;
+        int offset = bit & 63;
+        
+        uint64_t value = data[word] >> offset;
+        // Entries may straddle two words
+        if (offset + bitsPerEntry > 64) {
+            value |= data[word + 1] << (64 - offset);
+        }
+        return (uint32_t)(value & mask);
+    }
+    void writeIndex(int cell, uint32_t value);
+    int findOrAddPaletteEntry(BlockType type);
+    void resize(int newBits);
+    
+public:
+    static const int MIN_BITS = 0;
+    static const int MAX_BITS = 8;
+    
+    explicit PalettedContainer(BlockType fill = BlockType::AIR);
+    
+    static int cellIndex(int x, int y, int z) {
+        return (((x << SECTION_SHIFT) + z) << SECTION_SHIFT) + y;
+    }
+    
+    BlockType get(int cell) const { return palette[readIndex(cell)]; }
+    void set(int cell, BlockType type);
+    
+    // Drop unused palette entries and repack at the narrowest index width
+    void compact();
+    
+    bool isUniform() const { return liveEntries == 1; }
+    // Type filling the section when isUniform() is true
+    BlockType getUniformType() const;
+    
+    int getBitsPerEntry() const { return bitsPerEntry; }
+    int getPaletteSize() const { return liveEntries; }
+    size_t memoryUsage() const;
+};
+
+#endif // PALETTEDCONTAINER_H
@@ -0,0 +1,51 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// Counter-based random numbers: every value is a pure hash of (key, counter), so a
+// stream keyed by seed + chunk coordinate yields the same numbers no matter which
+// thread generates the chunk or in what order chunks are processed.
+class CounterRandom {
+private:
+    uint64_t key;
+    uint64_t counter;
+
+public:
+    // SplitMix64 finaliser: a cheap bijective 64-bit mix with full avalanche
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    
+    // Key for a chunk's stream; coordinates are folded in one at a time so
+    // neighbouring chunks get unrelated streams
+    static uint64_t chunkKey(uint64_t seed, int chunkX, int chunkY, int chunkZ) {
+        uint64_t h = mix(seed);
+        h = mix(h ^ (uint32_t)chunkX);
+        h = mix(h ^ (uint32_t)chunkY);
+        h = mix(h ^ (uint32_t)chunkZ);
+        return h;
+    }
+    
+    explicit CounterRandom(uint64_t key) : key(key), counter(0) {}
+    CounterRandom(uint64_t seed, int chunkX, int chunkY, int chunkZ)
+        : key(chunkKey(seed, chunkX, chunkY, chunkZ)), counter(0) {}
+    
+    uint32_t next() {
+        return (uint32_t)(mix(key + 0x9E3779B97F4A7C15ull * ++counter) >> 32);
+    }
+    
+    // Uniform integer in [0, bound)
+    int nextInt(int bound) {
+        return (int)(((uint64_t)next() * (uint32_t)bound) >> 32);
+    }
+    
+    // Uniform float in [0, 1)
+    float nextFloat() {
+        return (next() >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+#endif // RANDOM_H
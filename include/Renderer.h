@@ -6,11 +6,51 @@
 #include <GL/glut.h>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
 #include "World.h"
+#include "ChunkMesh.h"
+#include "ChunkDrawList.h"
+#include "GeometryArena.h"
+#include "ChunkShader.h"
+#include "MeshWorkerPool.h"
+#include "Frustum.h"
 #include "Vector3.h"
 #include "ImageLoader.h"
 #include "Inventory.h"
 
+// Per-chunk render bookkeeping
+struct ChunkRenderData {
+    ChunkMesh mesh;
+    bool buildPending; // A snapshot of this chunk is with the mesh workers
+    
+    ChunkRenderData() : buildPending(false) {}
+};
+
+// A chunk's translucent range, held back until every opaque chunk is queued so
+// the ranges can be drawn far to near
+struct TranslucentDraw {
+    GLint first;
+    GLsizei count;
+    Vector3 origin;
+    float distanceSquared; // From the camera to the chunk centre
+};
+
+// Per-frame chunk counters shown in the debug overlay
+struct RenderStats {
+    int chunksDrawn;
+    int chunksFrustumCulled;
+    int chunksOcclusionCulled;
+    int verticesDrawn;
+    int drawCalls;
+    int translucentChunks;
+    int chunksPerLod[ChunkMesher::MAX_LOD + 1];
+    
+    RenderStats() : chunksDrawn(0), chunksFrustumCulled(0), chunksOcclusionCulled(0), verticesDrawn(0), drawCalls(0),
+        translucentChunks(0), chunksPerLod() {}
+};
+
 // Block rendering modes
 enum class RenderMode {
     WIREFRAME,
@@ -23,6 +63,9 @@ private:
     RenderMode mode;
     World* world;
     Vector3 cameraPosition;
+    Vector3 previousPosition; // cameraPosition before the last update() step
+    float interpolation;      // How far rendering is between the two, 0..1
+    Vector3 eyePosition;      // Interpolated camera the current frame is drawn and culled from
     Vector3 velocity;
     float cameraYaw;
     float cameraPitch;
@@ -56,20 +99,49 @@ private:
     // Texture system
     GLuint textureAtlas;
     bool texturesLoaded;
+    ChunkShader chunkShader;
+    
+    // Cached chunk geometry, rebuilt in the background when a chunk's revision
+    // changes. Every mesh lives in the arena, so it is declared (and destroyed) first.
+    GeometryArena geometryArena;
+    ChunkDrawList chunkDrawLists[RENDER_LAYER_COUNT]; // One per pass, drawn in RenderLayer order
+    std::vector<TranslucentDraw> translucentDraws;
+    std::unordered_map<ChunkCoord, ChunkRenderData, ChunkCoordHash> chunkMeshes;
+    std::unique_ptr<MeshWorkerPool> meshWorkers;
+    float lodDistances[ChunkMesher::MAX_LOD]; // Beyond lodDistances[n], chunks use level n + 1
     
+    // Visibility
+    Frustum frustum;
+    std::unordered_set<ChunkCoord, ChunkCoordHash> reachableChunks;
+    RenderStats renderStats;
+    float framesPerSecond;
+
 public:
     Renderer(World* w);
     ~Renderer();
     
-    void init();
+    // False if the world can't be drawn on this GL (no usable chunk shader)
+    bool init();
     void initPlayerPosition();
     void render();
+    // Advance player physics by one fixed step
     void update(float deltaTime);
+    // Draw the camera this fraction of a step past the last completed one
+    void setInterpolation(float alpha) { interpolation = alpha; }
+    Vector3 getRenderPosition() const { return previousPosition + (cameraPosition - previousPosition) * interpolation; }
+    // Where the last frame was drawn from, for aiming at what the player saw
+    Vector3 getEyePosition() const { return eyePosition; }
     
     void setRenderMode(RenderMode m) { mode = m; }
     RenderMode getRenderMode() const { return mode; }
     
-    void setCameraPosition(Vector3 pos) { cameraPosition = pos; }
+    // Chunks are drawn as far out as the world keeps them loaded
+    float getRenderDistance() const { return (float)(world->getLoadRadius() * CHUNK_WIDTH); }
+    // Distance beyond which chunks drop to detail level lod + 1
+    float getLodDistance(int lod) const { return lodDistances[lod]; }
+    void setLodDistance(int lod, float distance) { lodDistances[lod] = distance; }
+    
+    void setCameraPosition(Vector3 pos) { cameraPosition = previousPosition = pos; }
     Vector3 getCameraPosition() const { return cameraPosition; }
     float getCameraYaw() const { return cameraYaw; }
     float getCameraPitch() const { return cameraPitch; }
@@ -88,7 +160,6 @@ public:
     bool isBlockAt(int x, int y, int z);
     bool isWaterAt(int x, int y, int z);
     int findGroundLevel(int x, int z);
-    bool shouldRenderFace(int x, int y, int z, int faceDirection);
     
     // Texture methods
     bool loadTextures();
@@ -107,6 +178,7 @@ public:
     void menuSelect();
     void renderMenu();
     void renderText(float x, float y, const char* text);
+    void renderDebugInfo();
     
     // Inventory methods
     void toggleInventory();
@@ -115,11 +187,14 @@ public:
     void renderHotbar();
     void selectHotbarSlot(int slot);
     Inventory& getInventory() { return inventory; }
-    
+
 private:
     void renderWorld();
-    void renderChunk(Chunk* chunk);
-    void renderBlock(Block& block, int x, int y, int z);
+    bool findReachableChunks();
+    bool renderChunk(Chunk* chunk, bool reachable, float distance);
+    // Detail level for a chunk at this horizontal distance, sticking with currentLod near a ring
+    int chooseLod(float distance, int currentLod) const;
+    void uploadFinishedMeshes();
     void setupCamera();
     void setupLighting();
 };
@@ -3,30 +3,128 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <unordered_map>
 #include "Chunk.h"
 #include "Vector3.h"
+#include "Noise.h"
+#include "ChunkGenerator.h"
+#include "LightEngine.h"
+#include "FluidSimulator.h"
 
-const int WORLD_WIDTH = 8;
+// Chunks stacked in every column; the world is only unbounded horizontally
 const int WORLD_HEIGHT = 4;
-const int WORLD_DEPTH = 8;
+
+// Columns within the load radius (in chunks) of the player are generated. Once
+// loaded they stay until further than the unload radius, so walking back and
+// forth across the edge doesn't regenerate the same columns over and over.
+// Distant chunks are drawn at reduced detail, so this reaches well past the
+// ring drawn at full detail.
+const int DEFAULT_LOAD_RADIUS = 16;
+const int UNLOAD_HYSTERESIS = 2;
+
+// Columns around the player generated before the game starts; the rest stream in
+const int SPAWN_RADIUS = 2;
+
+// Block ticks (water flow) run at a fixed rate whatever the frame rate. After a
+// stall at most MAX_TICKS_PER_UPDATE are caught up and the rest are dropped.
+const int TICKS_PER_SECOND = 20;
+const int MAX_TICKS_PER_UPDATE = 5;
+
+const uint64_t DEFAULT_WORLD_SEED = 0x4D79437261667421ull;
+
+// Result of World::raycast
+struct RaycastHit {
+    int x, y, z;                   // Block that was hit
+    int normalX, normalY, normalZ; // Outward normal of the face the ray entered through (zero if it started inside)
+    float distance;                // Distance along the ray to the entry point
+    Block block;
+};
 
 class World {
 private:
-    std::vector<std::vector<std::vector<std::shared_ptr<Chunk>>>> chunks;
+    std::unordered_map<ChunkCoord, std::shared_ptr<Chunk>, ChunkCoordHash> chunks;
+    // Changes whenever chunks are added or removed, so per-thread lookup caches
+    // know their cached pointer may be stale. Drawn from a process-wide counter,
+    // so two worlds never share a value.
+    uint64_t chunkMapEpoch;
     Vector3 playerPosition;
+    Vector3 viewDirection;
+    int loadRadius;
+    uint64_t seed;
+    Noise terrainNoise;
+    Noise biomeNoise;
+    LightEngine lighting;
+    FluidSimulator fluids;
+    float tickAccumulator; // Seconds of game time not yet run as ticks
+    // Declared last so its workers stop before anything they read is destroyed
+    std::unique_ptr<ChunkGenerator> generator;
     
+    void markChunkDirty(int x, int y, int z);
+    void chunkMapChanged();
+    // Fill one chunk from the seed; touches nothing but the chunk itself
+    int generateChunk(Chunk& chunk, int cx, int cy, int cz) const;
+    
+    // Chunk column the player stands in (y = 0)
+    ChunkCoord getPlayerColumn() const;
+    // Columns inside the radius that aren't loaded yet
+    std::vector<ChunkCoord> findMissingColumns(ChunkCoord center, int radius) const;
+    // Generate whole columns, splitting the chunks across threadCount threads; returns blocks placed
+    int generateColumns(const std::vector<ChunkCoord>& columns, int threadCount);
+    // Generation order: nearest first, with columns in front of the player pulled forward
+    float columnPriority(ChunkCoord center, ChunkCoord column) const;
+    void markColumnNeighboursDirty(ChunkCoord column);
+    // Light a column once it is in the map and linked
+    void lightColumn(ChunkCoord column);
+    // Connect a newly inserted chunk and whatever is loaded around it
+    void linkNeighbours(Chunk* chunk);
+    void unloadDistantColumns(ChunkCoord center);
+    
+    static bool columnInRadius(ChunkCoord center, int x, int z, int radius) {
+        int dx = x - center.x;
+        int dz = z - center.z;
+        return dx * dx + dz * dz <= radius * radius;
+    }    
 public:
-    World();
+    World(uint64_t seed = DEFAULT_WORLD_SEED);
     ~World();
     
-    void generateWorld();
-    void update();
+    // Generate the columns around the player in parallel (threadCount <= 0 uses
+    // all cores) and start the background generator for everything further out.
+    // The same seed always produces the same world, whatever the thread count.
+    void generateWorld(int threadCount = 0);
+    uint64_t getSeed() const { return seed; }
+    // Stream columns in and out around the current player position and run the
+    // block ticks due in deltaTime seconds. Finished columns are picked up
+    // without ever waiting on the generator.
+    void update(float deltaTime);
+    
+    int getLoadRadius() const { return loadRadius; }
+    void setLoadRadius(int radius) { loadRadius = radius; }
+    int getUnloadRadius() const { return loadRadius + UNLOAD_HYSTERESIS; }
+    size_t getLoadedChunkCount() const { return chunks.size(); }
+    int getQueuedColumnCount() const { return generator ? generator->getJobsQueued() : 0; }
+    int getCancelledColumnCount() const { return generator ? generator->getJobsCancelled() : 0; }
+    const FluidSimulator& getFluids() const { return fluids; }
     
+    // Chunk by chunk index; repeat lookups of the same chunk on a thread skip the hash map
     Chunk* getChunkAt(int x, int y, int z);
-    Block* getBlockAt(int x, int y, int z);
+    // Block by world coordinate (any sign); unloaded space reads as air
+    Block getBlockAt(int x, int y, int z);
+    // Collision query: one bit test in the chunk's opaque column masks
+    bool isBlockSolidAt(int x, int y, int z);
+    bool setBlockAt(int x, int y, int z, Block block);
+    
+    // Walk the ray voxel by voxel and report the first non-air block within maxDistance
+    bool raycast(const Vector3& origin, const Vector3& direction, float maxDistance, RaycastHit& hit);
+    
+    // Y of the highest solid block in the column at (x, z), or -1 if none
+    int getSurfaceHeight(int x, int z);
     
     Vector3 getPlayerPosition() const { return playerPosition; }
     void setPlayerPosition(Vector3 pos) { playerPosition = pos; }
+    // Horizontal look direction, used to generate what the player faces first
+    void setViewDirection(Vector3 dir) { viewDirection = dir; }
 };
 
 #endif // WORLD_H
@@ -1,55 +1,128 @@
 #include "Chunk.h"
 #include "Block.h"
+#include <algorithm>
 
-Chunk::Chunk(Vector3 pos) : position(pos) {
-    // Initialize chunk with empty blocks
-    blocks.resize(CHUNK_WIDTH, std::vector<std::vector<Block>>(
-        CHUNK_HEIGHT, std::vector<Block>(CHUNK_DEPTH, Block())));
+Chunk::Chunk(Vector3 pos) : position(pos), revision(0), uniformLight() {
+    for (int face = 0; face < FACE_COUNT; face++) {
+        neighbours[face] = nullptr;
+    }
 }
 
 Chunk::~Chunk() {
+    // Don't leave neighbours pointing at a chunk that no longer exists
+    for (int face = 0; face < FACE_COUNT; face++) {
+        if (neighbours[face]) {
+            neighbours[face]->setNeighbour(oppositeFace(face), nullptr);
+        }
+    }
 }
 
-Block& Chunk::getBlock(int x, int y, int z) {
-    // Bounds checking
-    if (x >= 0 && x < CHUNK_WIDTH && 
-        y >= 0 && y < CHUNK_HEIGHT && 
-        z >= 0 && z < CHUNK_DEPTH) {
-        return blocks[x][y][z];
+Block Chunk::getBlock(int x, int y, int z) const {
+    if (inBounds(x, y, z)) {
+        const PalettedContainer* section = sections[y / SECTION_SIZE].get();
+        if (section) {
+            return Block(section->get(PalettedContainer::cellIndex(x, y % SECTION_SIZE, z)));
+        }
     }
     
-    // Return a default block if out of bounds
-    static Block defaultBlock;
-    return defaultBlock;
+    // Out of bounds and unallocated sections are air
+    return Block();
 }
 
 void Chunk::setBlock(int x, int y, int z, Block block) {
-    // Bounds checking
-    if (x >= 0 && x < CHUNK_WIDTH && 
-        y >= 0 && y < CHUNK_HEIGHT && 
-        z >= 0 && z < CHUNK_DEPTH) {
-        blocks[x][y][z] = block;
+    if (!inBounds(x, y, z)) return;
+    
+    if (getBlock(x, y, z).type == block.type) return;
+    revision++;
+    
+    std::unique_ptr<PalettedContainer>& section = sections[y / SECTION_SIZE];
+    if (!section) {
+        section.reset(new PalettedContainer(BlockType::AIR));
+    }
+    
+    section->set(PalettedContainer::cellIndex(x, y % SECTION_SIZE, z), block.type);
+    
+    if (block.isSolid()) {
+        if (!opaqueColumns) {
+            opaqueColumns.reset(new ColumnMask[CHUNK_WIDTH * CHUNK_DEPTH]());
+        }
+        opaqueColumns[x * CHUNK_DEPTH + z].set(y);
+    } else if (opaqueColumns) {
+        opaqueColumns[x * CHUNK_DEPTH + z].reset(y);
+    }
+    
+    // Drop storage once the section collapses to a single type
+    if (section->isUniform()) {
+        if (section->getUniformType() == BlockType::AIR) {
+            section.reset();
+        } else {
+            section->compact();
+        }
     }
 }
 
-bool Chunk::isBlockSolid(int x, int y, int z) const {
-    // Bounds checking
-    if (x >= 0 && x < CHUNK_WIDTH && 
-        y >= 0 && y < CHUNK_HEIGHT && 
-        z >= 0 && z < CHUNK_DEPTH) {
-        return blocks[x][y][z].isSolid();
+void Chunk::setLight(int x, int y, int z, uint8_t light) {
+    int s = y >> SECTION_SHIFT;
+    std::unique_ptr<uint8_t[]>& section = lightSections[s];
+    if (!section) {
+        if (light == uniformLight[s]) return;
+        section.reset(new uint8_t[SECTION_VOLUME]);
+        std::fill_n(section.get(), SECTION_VOLUME, uniformLight[s]);
     }
-    
-    return false; // Assume non-solid outside chunk bounds
+    section[PalettedContainer::cellIndex(x, y & (SECTION_SIZE - 1), z)] = light;
+}
+
+void Chunk::fillSectionLight(int index, uint8_t light) {
+    lightSections[index].reset();
+    uniformLight[index] = light;
 }
 
 bool Chunk::isBlockEmpty(int x, int y, int z) const {
-    // Bounds checking
-    if (x >= 0 && x < CHUNK_WIDTH && 
-        y >= 0 && y < CHUNK_HEIGHT && 
-        z >= 0 && z < CHUNK_DEPTH) {
-        return blocks[x][y][z].isEmpty();
+    if (inBounds(x, y, z)) {
+        return getBlock(x, y, z).isEmpty();
     }
     
     return true; // Assume empty outside chunk bounds
 }
+
+bool Chunk::isEmpty() const {
+    for (int s = 0; s < CHUNK_SECTIONS; s++) {
+        if (sections[s]) return false;
+    }
+    return true;
+}
+
+int Chunk::getHighestSolidY(int x, int z) const {
+    // Highest set bit of the column's opaque mask
+    if (!opaqueColumns) return -1;
+    return opaqueColumns[x * CHUNK_DEPTH + z].highest();
+}
+
+void Chunk::compact() {
+    for (std::unique_ptr<PalettedContainer>& section : sections) {
+        if (!section) continue;
+        
+        section->compact();
+        if (section->isUniform() && section->getUniformType() == BlockType::AIR) {
+            section.reset();
+        }
+    }
+}
+
+size_t Chunk::memoryUsage() const {
+    size_t bytes = sizeof(*this);
+    if (opaqueColumns) {
+        bytes += CHUNK_WIDTH * CHUNK_DEPTH * sizeof(ColumnMask);
+    }
+    for (const std::unique_ptr<PalettedContainer>& section : sections) {
+        if (section) {
+            bytes += section->memoryUsage();
+        }
+    }
+    for (const std::unique_ptr<uint8_t[]>& section : lightSections) {
+        if (section) {
+            bytes += SECTION_VOLUME;
+        }
+    }
+    return bytes;
+}
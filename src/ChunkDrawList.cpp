@@ -0,0 +1,92 @@
+#include "ChunkDrawList.h"
+#include "ChunkShader.h"
+#include <cstdio>
+#include <cstddef>
+#include <iostream>
+
+namespace {
+
+bool hasVersion(int wantMajor, int wantMinor) {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    if (!version || sscanf(version, "%d.%d", &major, &minor) != 2) return false;
+    return major > wantMajor || (major == wantMajor && minor >= wantMinor);
+}
+
+} // namespace
+
+ChunkDrawList::ChunkDrawList() : indirect(false), commandBuffer(0), originBuffer(0), lastDrawCalls(0) {
+}
+
+ChunkDrawList::~ChunkDrawList() {
+    if (commandBuffer != 0) glDeleteBuffers(1, &commandBuffer);
+    if (originBuffer != 0) glDeleteBuffers(1, &originBuffer);
+}
+
+void ChunkDrawList::init() {
+    // Base instances select the origin, and the origin attribute advances once per
+    // draw. Only core 4.3 guarantees the unsuffixed entry points called below; an
+    // older context with just the ARB extensions exports the ARB-named ones.
+    indirect = hasVersion(4, 3);
+    if (indirect) {
+        glGenBuffers(1, &commandBuffer);
+        glGenBuffers(1, &originBuffer);
+    }
+    std::cout << "Chunk draws: " << (indirect ? "one multi-draw indirect call per frame" : "one draw per chunk")
+              << std::endl;
+}
+
+void ChunkDrawList::clear() {
+    commands.clear();
+    origins.clear();
+}
+
+void ChunkDrawList::add(GLint first, GLsizei count, const Vector3& origin) {
+    DrawArraysIndirectCommand command;
+    command.count = (GLuint)count;
+    command.instanceCount = 1;
+    command.first = (GLuint)first;
+    command.baseInstance = (GLuint)commands.size();
+    commands.push_back(command);
+    origins.push_back(origin.x);
+    origins.push_back(origin.y);
+    origins.push_back(origin.z);
+}
+
+void ChunkDrawList::submit(const GeometryArena& arena) {
+    lastDrawCalls = 0;
+    if (commands.empty()) return;
+    
+    // Bytes go to the shader unnormalised, so it sees whole block units
+    const GLsizei stride = sizeof(ChunkVertex);
+    glBindBuffer(GL_ARRAY_BUFFER, arena.getBuffer());
+    glVertexAttribPointer(ChunkShader::POSITION_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_FALSE, stride,
+                          (const void*)offsetof(ChunkVertex, x));
+    glVertexAttribPointer(ChunkShader::INFO_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_FALSE, stride,
+                          (const void*)offsetof(ChunkVertex, face));
+    
+    if (indirect) {
+        glBindBuffer(GL_ARRAY_BUFFER, originBuffer);
+        glBufferData(GL_ARRAY_BUFFER, origins.size() * sizeof(GLfloat), origins.data(), GL_STREAM_DRAW);
+        glVertexAttribPointer(ChunkShader::ORIGIN_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribDivisor(ChunkShader::ORIGIN_ATTRIBUTE, 1);
+        glEnableVertexAttribArray(ChunkShader::ORIGIN_ATTRIBUTE);
+        
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawArraysIndirectCommand),
+                     commands.data(), GL_STREAM_DRAW);
+        glMultiDrawArraysIndirect(GL_QUADS, nullptr, (GLsizei)commands.size(), 0);
+        lastDrawCalls = 1;
+        
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glDisableVertexAttribArray(ChunkShader::ORIGIN_ATTRIBUTE);
+        glVertexAttribDivisor(ChunkShader::ORIGIN_ATTRIBUTE, 0);
+    } else {
+        for (size_t i = 0; i < commands.size(); i++) {
+            glVertexAttrib3fv(ChunkShader::ORIGIN_ATTRIBUTE, &origins[i * 3]);
+            glDrawArrays(GL_QUADS, (GLint)commands[i].first, (GLsizei)commands[i].count);
+        }
+        lastDrawCalls = (int)commands.size();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
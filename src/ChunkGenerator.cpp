@@ -0,0 +1,91 @@
+#include "ChunkGenerator.h"
+#include <algorithm>
+
+ChunkGenerator::ChunkGenerator(GenerateFunction generate, int columnHeight, int threadCount)
+    : generate(generate), columnHeight(columnHeight), stopping(false), jobsCancelled(0) {
+    if (threadCount <= 0) {
+        // Leave a core for the GLUT thread
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    }
+    
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ChunkGenerator::workerLoop, this);
+    }
+}
+
+ChunkGenerator::~ChunkGenerator() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ChunkGenerator::schedule(std::vector<ColumnJob> newJobs) {
+    // Worst first, so workers take the best job from the back in O(1)
+    std::sort(newJobs.begin(), newJobs.end(), [](const ColumnJob& a, const ColumnJob& b) {
+        return a.priority > b.priority;
+    });
+    
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        
+        // Anything waiting that the caller no longer asks for is cancelled
+        std::unordered_set<ChunkCoord, ChunkCoordHash> wanted;
+        for (const ColumnJob& job : newJobs) {
+            wanted.insert(job.column);
+        }
+        int cancelled = 0;
+        for (const ColumnJob& job : jobs) {
+            if (!wanted.count(job.column)) cancelled++;
+        }
+        jobsCancelled.fetch_add(cancelled, std::memory_order_relaxed);
+        
+        newJobs.erase(std::remove_if(newJobs.begin(), newJobs.end(), [this](const ColumnJob& job) {
+            return activeColumns.count(job.column) > 0;
+        }), newJobs.end());
+        jobs.swap(newJobs);
+    }
+    jobAvailable.notify_all();
+}
+
+bool ChunkGenerator::pollResult(GeneratedColumn& out) {
+    if (!results.pop(out)) return false;
+    
+    std::lock_guard<std::mutex> lock(jobMutex);
+    activeColumns.erase(out.column);
+    return true;
+}
+
+int ChunkGenerator::getJobsQueued() const {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    return (int)jobs.size();
+}
+
+void ChunkGenerator::workerLoop() {
+    for (;;) {
+        ChunkCoord column;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            
+            column = jobs.back().column;
+            jobs.pop_back();
+            activeColumns.insert(column);
+        }
+        
+        GeneratedColumn result;
+        result.column = column;
+        for (int cy = 0; cy < columnHeight; cy++) {
+            std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(Vector3(column.x, cy, column.z));
+            generate(*chunk);
+            result.chunks.push_back(chunk);
+        }
+        results.push(std::move(result));
+    }
+}
@@ -0,0 +1,47 @@
+#include "ChunkMesh.h"
+#include <algorithm>
+
+ChunkMesh::ChunkMesh() : arena(nullptr), arenaHandle(GeometryArena::INVALID_HANDLE), vertexCount(0), layerStart(),
+    revision(0), lod(0), built(false), faceConnectivity(ChunkMesher::ALL_FACES_CONNECTED) {
+}
+
+ChunkMesh::~ChunkMesh() {
+    release();
+}
+
+void ChunkMesh::upload(const ChunkMeshData& data, uint32_t chunkRevision, GeometryArena& geometryArena) {
+    release();
+    revision = chunkRevision;
+    lod = data.lod;
+    built = true;
+    faceConnectivity = data.faceConnectivity;
+    vertexCount = (GLsizei)data.vertices.size();
+    std::copy(data.layerStart, data.layerStart + RENDER_LAYER_COUNT + 1, layerStart);
+    
+    if (vertexCount == 0) return;
+    
+    uint8_t lo[3] = { 255, 255, 255 };
+    uint8_t hi[3] = { 0, 0, 0 };
+    for (const ChunkVertex& v : data.vertices) {
+        const uint8_t corner[3] = { v.x, v.y, v.z };
+        for (int axis = 0; axis < 3; axis++) {
+            lo[axis] = std::min(lo[axis], corner[axis]);
+            hi[axis] = std::max(hi[axis], corner[axis]);
+        }
+    }
+    boundsMin = Vector3(lo[0], lo[1], lo[2]);
+    boundsMax = Vector3(hi[0], hi[1], hi[2]);
+    
+    arena = &geometryArena;
+    arenaHandle = arena->allocate(data.vertices);
+}
+
+void ChunkMesh::release() {
+    if (arena) {
+        arena->release(arenaHandle);
+        arena = nullptr;
+        arenaHandle = GeometryArena::INVALID_HANDLE;
+    }
+    vertexCount = 0;
+    std::fill_n(layerStart, RENDER_LAYER_COUNT + 1, 0);
+}
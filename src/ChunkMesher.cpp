@@ -0,0 +1,638 @@
+#include "ChunkMesher.h"
+#include <algorithm>
+
+namespace {
+
+// Axis each face's normal runs along (0=x, 1=y, 2=z)
+const int FACE_AXIS[6] = { 2, 2, 1, 1, 0, 0 };
+
+// Corners of each face, counter-clockwise seen from outside the block. The
+// first two corners are the bottom edge of the texture.
+const int FACE_CORNERS[6][4][3] = {
+    { { 1, 0, 0 }, { 0, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } }, // front
+    { { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } }, // back
+    { { 0, 1, 1 }, { 1, 1, 1 }, { 1, 1, 0 }, { 0, 1, 0 } }, // top
+    { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 } }, // bottom
+    { { 1, 0, 1 }, { 1, 0, 0 }, { 1, 1, 0 }, { 1, 1, 1 } }, // right
+    { { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 } }  // left
+};
+
+const int CHUNK_SIZE[3] = { CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_DEPTH };
+
+// Whether a block hides the faces of the blocks next to it, by block ID, so
+// face culling is a table lookup rather than a branch
+struct OccluderTable {
+    bool occludes[256];
+    bool hidesSameType[256]; // Translucent blocks drop the faces they share, water against water
+    
+    constexpr OccluderTable() : occludes(), hidesSameType() {
+        for (int type = 0; type < BLOCK_TYPE_COUNT; type++) {
+            occludes[type] = type != BlockType::AIR && BLOCK_PROPERTIES[type].solid;
+            hidesSameType[type] = BLOCK_PROPERTIES[type].layer == RenderLayer::TRANSLUCENT;
+        }
+    }
+};
+
+constexpr OccluderTable OCCLUDERS;
+
+// Ambient occlusion neighbours of each face corner, as index steps from the cell
+// in front of the face: the two blocks beside the corner along the face's axes,
+// then the one diagonally across it
+struct AmbientOcclusionTable {
+    int offsets[FACE_COUNT][4][3];
+    
+    constexpr AmbientOcclusionTable() : offsets() {
+        for (int face = 0; face < FACE_COUNT; face++) {
+            int n = FACE_AXIS[face];
+            for (int corner = 0; corner < 4; corner++) {
+                int side[2][3] = { { 0, 0, 0 }, { 0, 0, 0 } };
+                for (int k = 0; k < 2; k++) {
+                    int axis = (n + 1 + k) % 3;
+                    side[k][axis] = FACE_CORNERS[face][corner][axis] ? 1 : -1;
+                }
+                for (int k = 0; k < 3; k++) {
+                    int d[3] = { 0, 0, 0 };
+                    for (int axis = 0; axis < 3; axis++) {
+                        d[axis] = k == 2 ? side[0][axis] + side[1][axis] : side[k][axis];
+                    }
+                    offsets[face][corner][k] = (d[0] * PADDED_DEPTH + d[2]) * PADDED_HEIGHT + d[1];
+                }
+            }
+        }
+    }
+};
+
+constexpr AmbientOcclusionTable AO_NEIGHBOURS;
+
+static_assert(64 % SECTION_SIZE == 0, "A section must not straddle two ColumnMask words");
+
+// Cells of every column whose face in each direction is not hidden by an opaque
+// neighbour, stored as visible[face * CHUNK_WIDTH * CHUNK_DEPTH + x * CHUNK_DEPTH + z].
+// Sideways this is present & ~(adjacent column's opaque mask); up and down the
+// neighbour mask is the column's own, shifted one bit, with the end bit carried
+// in from the padding row above or below the chunk.
+void computeVisibleFaces(const ChunkSnapshot& snapshot, std::vector<ColumnMask>& visible) {
+    const int columns = CHUNK_WIDTH * CHUNK_DEPTH;
+    visible.resize(FACE_COUNT * columns);
+    
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int z = 0; z < CHUNK_DEPTH; z++) {
+            int column = x * CHUNK_DEPTH + z;
+            const ColumnMask& present = snapshot.present[column];
+            const ColumnMask& own = snapshot.opaque[ChunkSnapshot::columnIndex(x, z)];
+            uint64_t aboveTop = OCCLUDERS.occludes[snapshot.getBlock(x, CHUNK_HEIGHT, z)];
+            uint64_t belowBottom = OCCLUDERS.occludes[snapshot.getBlock(x, -1, z)];
+            
+            for (int face = 0; face < FACE_COUNT; face++) {
+                ColumnMask& out = visible[face * columns + column];
+                for (int w = 0; w < COLUMN_WORDS; w++) {
+                    uint64_t neighbour;
+                    if (face == 2) {
+                        uint64_t carry = w + 1 < COLUMN_WORDS ? own.words[w + 1] & 1 : aboveTop;
+                        neighbour = (own.words[w] >> 1) | (carry << 63);
+                    } else if (face == 3) {
+                        uint64_t carry = w > 0 ? own.words[w - 1] >> 63 : belowBottom;
+                        neighbour = (own.words[w] << 1) | carry;
+                    } else {
+                        int nx = x + FACE_DIRECTIONS[face][0];
+                        int nz = z + FACE_DIRECTIONS[face][2];
+                        neighbour = snapshot.opaque[ChunkSnapshot::columnIndex(nx, nz)].words[w];
+                    }
+                    out.words[w] = present.words[w] & ~neighbour;
+                }
+            }
+        }
+    }
+}
+
+// What a greedy quad must share to merge: block type in the low byte, packed
+// light in the next, then the four corners' occlusion at two bits each.
+// Zero (air) is no face.
+typedef uint32_t FaceKey;
+const FaceKey NO_FACE = 0;
+const uint8_t UNOCCLUDED = 0xFF; // Every corner at AO_LEVELS - 1
+
+inline FaceKey makeFaceKey(BlockType type, uint8_t light, uint8_t occlusion = UNOCCLUDED) {
+    return (FaceKey)type | (FaceKey)light << 8 | (FaceKey)occlusion << 16;
+}
+
+// Occlusion of every corner of a face, packed as makeFaceKey takes it. A corner
+// between two opaque sides is fully dark whatever the diagonal holds.
+uint8_t faceOcclusion(const BlockType* blocks, int front, int face) {
+    uint8_t packed = 0;
+    for (int corner = 0; corner < 4; corner++) {
+        const int* offsets = AO_NEIGHBOURS.offsets[face][corner];
+        int side1 = OCCLUDERS.occludes[blocks[front + offsets[0]]];
+        int side2 = OCCLUDERS.occludes[blocks[front + offsets[1]]];
+        int diagonal = OCCLUDERS.occludes[blocks[front + offsets[2]]];
+        int level = (side1 && side2) ? 0 : ChunkVertex::AO_LEVELS - 1 - (side1 + side2 + diagonal);
+        packed |= (uint8_t)(level << (corner * 2));
+    }
+    return packed;
+}
+
+// Quads as they are emitted, one list per render layer, joined into the mesh at the end
+struct LayeredVertices {
+    std::vector<ChunkVertex> layers[RENDER_LAYER_COUNT];
+    
+    void moveInto(ChunkMeshData& out) {
+        size_t total = 0;
+        for (int layer = 0; layer < RENDER_LAYER_COUNT; layer++) {
+            total += layers[layer].size();
+        }
+        out.vertices.reserve(total);
+        for (int layer = 0; layer < RENDER_LAYER_COUNT; layer++) {
+            out.layerStart[layer] = (uint32_t)out.vertices.size();
+            out.vertices.insert(out.vertices.end(), layers[layer].begin(), layers[layer].end());
+        }
+        out.layerStart[RENDER_LAYER_COUNT] = (uint32_t)out.vertices.size();
+    }
+};
+
+// Whether the face between a block and its neighbour is hidden: behind an opaque
+// block, or between two translucent blocks of the same type, where the shared
+// face would only show up as a seam inside the water
+inline bool faceHidden(BlockType type, BlockType neighbour) {
+    return OCCLUDERS.occludes[neighbour] || (neighbour == type && OCCLUDERS.hidesSameType[type]);
+}
+
+void emitQuad(LayeredVertices& out, int face, FaceKey key, const int cell[3], const int size[3]) {
+    BlockType type = (BlockType)(key & 0xFF);
+    std::vector<ChunkVertex>& layer = out.layers[(int)getBlockProperties(type).layer];
+    int ao[4];
+    for (int corner = 0; corner < 4; corner++) {
+        ao[corner] = (key >> (16 + corner * 2)) & 3;
+    }
+    
+    // Quads are split along the diagonal from their first vertex. Start from
+    // corner 1 instead when that diagonal is the darker one, so the gradient
+    // doesn't depend on which way the quad happens to be split.
+    int first = (ao[0] + ao[2] < ao[1] + ao[3]) ? 1 : 0;
+    for (int i = 0; i < 4; i++) {
+        int corner = (first + i) & 3;
+        ChunkVertex vertex;
+        vertex.x = (uint8_t)(cell[0] + FACE_CORNERS[face][corner][0] * size[0]);
+        vertex.y = (uint8_t)(cell[1] + FACE_CORNERS[face][corner][1] * size[1]);
+        vertex.z = (uint8_t)(cell[2] + FACE_CORNERS[face][corner][2] * size[2]);
+        vertex.tile = (uint8_t)type;
+        vertex.face = (uint8_t)face;
+        vertex.ao = (uint8_t)ao[corner];
+        vertex.light = (uint8_t)(key >> 8);
+        vertex.reserved = 0;
+        layer.push_back(vertex);
+    }
+}
+
+// Merge runs of the same face key in one slice's face mask into the largest
+// rectangles we can and emit them. Mask entry (i, j) is the face of the cell at
+// base + i along the slice's first axis and + j along its second; cells are
+// scale blocks on a side. Every entry is NO_FACE again afterwards.
+void emitSlice(LayeredVertices& out, int face, FaceKey* mask, int widthA, int widthB, const int base[3], int scale) {
+    int n = FACE_AXIS[face];
+    int a = (n + 1) % 3;
+    int b = (n + 2) % 3;
+    
+    for (int j = 0; j < widthB; j++) {
+        for (int i = 0; i < widthA; ) {
+            FaceKey key = mask[j * widthA + i];
+            if (key == NO_FACE) {
+                i++;
+                continue;
+            }
+            
+            int w = 1;
+            while (i + w < widthA && mask[j * widthA + i + w] == key) w++;
+            
+            int h = 1;
+            for (; j + h < widthB; h++) {
+                bool rowMatches = true;
+                for (int k = 0; k < w; k++) {
+                    if (mask[(j + h) * widthA + i + k] != key) {
+                        rowMatches = false;
+                        break;
+                    }
+                }
+                if (!rowMatches) break;
+            }
+            
+            int cell[3], size[3];
+            cell[n] = base[n] * scale;
+            cell[a] = (base[a] + i) * scale;
+            cell[b] = (base[b] + j) * scale;
+            size[n] = scale;
+            size[a] = w * scale;
+            size[b] = h * scale;
+            emitQuad(out, face, key, cell, size);
+            
+            for (int dh = 0; dh < h; dh++) {
+                for (int k = 0; k < w; k++) {
+                    mask[(j + dh) * widthA + i + k] = NO_FACE;
+                }
+            }
+            i += w;
+        }
+    }
+}
+
+// Coarse grid for a level-of-detail mesh, cells of scale blocks on a side stored
+// as (x * dims[2] + z) * dims[1] + y. A cell is filled when at least half its
+// blocks are; it takes the most common type of its highest non-empty layer, so
+// the surface keeps its top block (grass over dirt) rather than the bulk below.
+void downsample(const ChunkSnapshot& snapshot, int scale, const int dims[3], std::vector<BlockType>& coarse) {
+    coarse.assign(dims[0] * dims[1] * dims[2], BlockType::AIR);
+    const int volume = scale * scale * scale;
+    int counts[BLOCK_TYPE_COUNT];
+    
+    for (int cx = 0; cx < dims[0]; cx++) {
+        for (int cz = 0; cz < dims[2]; cz++) {
+            for (int cy = snapshot.minY / scale; cy < snapshot.maxY / scale; cy++) {
+                int filled = 0;
+                BlockType top = BlockType::AIR;
+                for (int y = (cy + 1) * scale - 1; y >= cy * scale; y--) {
+                    std::fill_n(counts, BLOCK_TYPE_COUNT, 0);
+                    int layerFilled = 0;
+                    for (int x = cx * scale; x < (cx + 1) * scale; x++) {
+                        for (int z = cz * scale; z < (cz + 1) * scale; z++) {
+                            BlockType type = snapshot.getBlock(x, y, z);
+                            if (type == BlockType::AIR || type >= BLOCK_TYPE_COUNT) continue;
+                            counts[type]++;
+                            layerFilled++;
+                        }
+                    }
+                    if (layerFilled > 0 && top == BlockType::AIR) {
+                        top = (BlockType)(std::max_element(counts, counts + BLOCK_TYPE_COUNT) - counts);
+                    }
+                    filled += layerFilled;
+                }
+                if (filled * 2 >= volume) {
+                    coarse[(cx * dims[2] + cz) * dims[1] + cy] = top;
+                }
+            }
+        }
+    }
+}
+
+// Mesh for level of detail snapshot.lod, lit as if open to the sky and without
+// ambient occlusion: both are too fine a detail to carry into coarse cells.
+// Coarse faces are culled against coarse neighbours inside the chunk; across
+// the chunk boundary they are only hidden when every full-detail block behind
+// them is opaque, so a coarse surface that ends up lower than its neighbour's
+// shows its side. Where it ends up higher, the neighbour hid its boundary faces
+// against blocks this mesh no longer draws, so the gap is closed with those
+// faces ("seam walls") at full detail on the boundary plane.
+void buildLodMesh(const ChunkSnapshot& snapshot, LayeredVertices& out) {
+    const int scale = 1 << snapshot.lod;
+    const int dims[3] = { CHUNK_WIDTH / scale, CHUNK_HEIGHT / scale, CHUNK_DEPTH / scale };
+    std::vector<BlockType> coarse;
+    downsample(snapshot, scale, dims, coarse);
+    auto coarseAt = [&](const int c[3]) {
+        return coarse[(c[0] * dims[2] + c[2]) * dims[1] + c[1]];
+    };
+    std::vector<FaceKey> mask;
+    
+    for (int face = 0; face < FACE_COUNT; face++) {
+        int n = FACE_AXIS[face];
+        int a = (n + 1) % 3;
+        int b = (n + 2) % 3;
+        int step = FACE_DIRECTIONS[face][n];
+        mask.assign(dims[a] * dims[b], NO_FACE);
+        
+        for (int d = 0; d < dims[n]; d++) {
+            bool boundary = (step > 0) ? d == dims[n] - 1 : d == 0;
+            int c[3];
+            c[n] = d;
+            for (int j = 0; j < dims[b]; j++) {
+                for (int i = 0; i < dims[a]; i++) {
+                    c[a] = i;
+                    c[b] = j;
+                    BlockType type = coarseAt(c);
+                    if (type == BlockType::AIR) continue;
+                    
+                    bool hidden = true;
+                    if (!boundary) {
+                        int next[3] = { c[0], c[1], c[2] };
+                        next[n] += step;
+                        hidden = faceHidden(type, coarseAt(next));
+                    } else {
+                        // The padding layer across this cell's face
+                        int p[3];
+                        p[n] = step > 0 ? CHUNK_SIZE[n] : -1;
+                        for (int u = 0; u < scale && hidden; u++) {
+                            for (int v = 0; v < scale && hidden; v++) {
+                                p[a] = i * scale + u;
+                                p[b] = j * scale + v;
+                                hidden = faceHidden(type, snapshot.getBlock(p[0], p[1], p[2]));
+                            }
+                        }
+                    }
+                    if (!hidden) mask[j * dims[a] + i] = makeFaceKey(type, ChunkVertex::FULL_LIGHT);
+                }
+            }
+            
+            int base[3];
+            base[n] = d;
+            base[a] = 0;
+            base[b] = 0;
+            emitSlice(out, face, mask.data(), dims[a], dims[b], base, scale);
+        }
+        
+        // Seam walls: the neighbour's faces on this boundary, facing into the chunk,
+        // wherever the neighbour hid them against a block the coarse grid dropped
+        int widthA = CHUNK_SIZE[a];
+        int widthB = CHUNK_SIZE[b];
+        mask.assign(widthA * widthB, NO_FACE);
+        int p[3], c[3];
+        p[n] = step > 0 ? CHUNK_SIZE[n] - 1 : 0;
+        c[n] = p[n] / scale;
+        bool anyWall = false;
+        for (int j = 0; j < widthB; j++) {
+            for (int i = 0; i < widthA; i++) {
+                p[a] = i;
+                p[b] = j;
+                c[a] = i / scale;
+                c[b] = j / scale;
+                if (OCCLUDERS.occludes[coarseAt(c)]) continue;
+                if (!OCCLUDERS.occludes[snapshot.getBlock(p[0], p[1], p[2])]) continue;
+                
+                int index = ChunkSnapshot::paddedIndex(p[0], p[1], p[2]) + ChunkSnapshot::faceOffset(face);
+                BlockType outside = snapshot.blocks[index];
+                if (OCCLUDERS.occludes[outside]) {
+                    mask[j * widthA + i] = makeFaceKey(outside, ChunkVertex::FULL_LIGHT);
+                    anyWall = true;
+                }
+            }
+        }
+        if (anyWall) {
+            int base[3];
+            base[n] = step > 0 ? CHUNK_SIZE[n] : -1;
+            base[a] = 0;
+            base[b] = 0;
+            emitSlice(out, oppositeFace(face), mask.data(), widthA, widthB, base, 1);
+        }
+    }
+}
+
+// Chunk face a cell lies on, as a bit per face direction
+int boundaryFaces(int x, int y, int z) {
+    int faces = 0;
+    if (z == 0) faces |= 1 << 0;
+    if (z == CHUNK_DEPTH - 1) faces |= 1 << 1;
+    if (y == CHUNK_HEIGHT - 1) faces |= 1 << 2;
+    if (y == 0) faces |= 1 << 3;
+    if (x == CHUNK_WIDTH - 1) faces |= 1 << 4;
+    if (x == 0) faces |= 1 << 5;
+    return faces;
+}
+
+} // namespace
+
+void ChunkMesher::getTileUV(BlockType type, float& u, float& v, float& size) {
+    int index = (int)type;
+    size = 1.0f / ATLAS_TILES_PER_ROW;
+    u = (index % ATLAS_TILES_PER_ROW) * size;
+    v = (index / ATLAS_TILES_PER_ROW) * size;
+}
+
+void ChunkMesher::getFaceTextureAxes(int face, int uAxis[3], int vAxis[3]) {
+    // u runs from corner 0 to corner 1; v runs from corner 2 back to corner 1,
+    // since atlas v grows downwards and the first two corners are the bottom edge
+    for (int axis = 0; axis < 3; axis++) {
+        uAxis[axis] = FACE_CORNERS[face][1][axis] - FACE_CORNERS[face][0][axis];
+        vAxis[axis] = FACE_CORNERS[face][1][axis] - FACE_CORNERS[face][2][axis];
+    }
+}
+
+std::unique_ptr<ChunkSnapshot> ChunkSnapshot::capture(const Chunk& chunk, int lod) {
+    std::unique_ptr<ChunkSnapshot> snapshot(new ChunkSnapshot());
+    snapshot->coord = chunk.getCoord();
+    snapshot->revision = chunk.getRevision();
+    snapshot->lod = std::max(0, std::min(lod, ChunkMesher::MAX_LOD));
+    snapshot->ambientOcclusion = true;
+    snapshot->minY = CHUNK_HEIGHT;
+    snapshot->maxY = 0;
+    snapshot->blocks.assign(PADDED_VOLUME, BlockType::AIR);
+    snapshot->present.assign(CHUNK_WIDTH * CHUNK_DEPTH, ColumnMask());
+    snapshot->opaque.assign(PADDED_WIDTH * PADDED_DEPTH, ColumnMask());
+    snapshot->light.assign(PADDED_VOLUME, FULL_SKY_LIGHT);
+    
+    // Decode the palette sections once; greedy slicing reads every cell up to six times
+    for (int s = 0; s < CHUNK_SECTIONS; s++) {
+        const PalettedContainer* section = chunk.getSection(s);
+        if (!section) continue;
+        
+        snapshot->minY = std::min(snapshot->minY, s * SECTION_SIZE);
+        snapshot->maxY = std::max(snapshot->maxY, s * SECTION_SIZE + SECTION_SIZE);
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            for (int z = 0; z < CHUNK_DEPTH; z++) {
+                BlockType* column = &snapshot->blocks[paddedIndex(x, s * SECTION_SIZE, z)];
+                uint64_t bits = 0;
+                for (int sy = 0; sy < SECTION_SIZE; sy++) {
+                    column[sy] = section->get(PalettedContainer::cellIndex(x, sy, z));
+                    bits |= (uint64_t)(column[sy] != BlockType::AIR) << sy;
+                }
+                int y = s * SECTION_SIZE;
+                snapshot->present[x * CHUNK_DEPTH + z].words[y >> 6] |= bits << (y & 63);
+            }
+        }
+    }
+    
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int z = 0; z < CHUNK_DEPTH; z++) {
+            snapshot->opaque[columnIndex(x, z)] = chunk.getOpaqueColumn(x, z);
+            uint8_t* light = &snapshot->light[paddedIndex(x, 0, z)];
+            for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                light[y] = chunk.getLight(x, y, z);
+            }
+        }
+    }
+    
+    // Fill the padding from the 26 surrounding chunks, reached by walking face links.
+    // Along an axis with no offset the whole span is copied; otherwise only the
+    // layer touching this chunk.
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                if (dx == 0 && dy == 0 && dz == 0) continue;
+                
+                const Chunk* source = &chunk;
+                if (dx != 0) source = source->getNeighbour(dx > 0 ? 4 : 5);
+                if (source && dy != 0) source = source->getNeighbour(dy > 0 ? 2 : 3);
+                if (source && dz != 0) source = source->getNeighbour(dz > 0 ? 1 : 0);
+                if (!source) continue; // Not loaded: stays air
+                
+                const int offset[3] = { dx, dy, dz };
+                int first[3], count[3], sourceFirst[3];
+                for (int axis = 0; axis < 3; axis++) {
+                    int size = CHUNK_SIZE[axis];
+                    first[axis] = offset[axis] < 0 ? -1 : (offset[axis] > 0 ? size : 0);
+                    count[axis] = offset[axis] == 0 ? size : 1;
+                    sourceFirst[axis] = offset[axis] < 0 ? size - 1 : 0;
+                }
+                
+                for (int i = 0; i < count[0]; i++) {
+                    for (int k = 0; k < count[2]; k++) {
+                        if (dy == 0) {
+                            snapshot->opaque[columnIndex(first[0] + i, first[2] + k)] =
+                                source->getOpaqueColumn(sourceFirst[0] + i, sourceFirst[2] + k);
+                        }
+                        int index = paddedIndex(first[0] + i, first[1], first[2] + k);
+                        BlockType* column = &snapshot->blocks[index];
+                        uint8_t* light = &snapshot->light[index];
+                        for (int j = 0; j < count[1]; j++) {
+                            int sx = sourceFirst[0] + i, sy = sourceFirst[1] + j, sz = sourceFirst[2] + k;
+                            column[j] = source->getBlockUnchecked(sx, sy, sz).type;
+                            light[j] = source->getLight(sx, sy, sz);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    return snapshot;
+}
+
+uint64_t ChunkMesher::computeFaceConnectivity(const ChunkSnapshot& snapshot) {
+    if (snapshot.minY >= snapshot.maxY) return ALL_FACES_CONNECTED;
+    
+    // Flood fill every region of non-solid cells and record which chunk faces
+    // each region touches; any two faces touched by one region can see each other.
+    // The padding starts out visited, so the fill never steps outside the chunk.
+    uint64_t connectivity = 0;
+    std::vector<uint8_t> visited(PADDED_VOLUME, 1);
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int z = 0; z < CHUNK_DEPTH; z++) {
+            std::fill_n(&visited[ChunkSnapshot::paddedIndex(x, 0, z)], CHUNK_HEIGHT, 0);
+        }
+    }
+    int neighbourOffsets[FACE_COUNT];
+    for (int dir = 0; dir < FACE_COUNT; dir++) {
+        neighbourOffsets[dir] = ChunkSnapshot::faceOffset(dir);
+    }
+    std::vector<int> stack;
+    
+    for (int start = 0; start < PADDED_VOLUME; start++) {
+        if (visited[start] || getBlockProperties(snapshot.blocks[start]).solid) continue;
+        
+        int faces = 0;
+        visited[start] = 1;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int index = stack.back();
+            stack.pop_back();
+            
+            int y = index % PADDED_HEIGHT - 1;
+            int z = (index / PADDED_HEIGHT) % PADDED_DEPTH - 1;
+            int x = index / (PADDED_HEIGHT * PADDED_DEPTH) - 1;
+            faces |= boundaryFaces(x, y, z);
+            
+            for (int dir = 0; dir < FACE_COUNT; dir++) {
+                int next = index + neighbourOffsets[dir];
+                if (visited[next] || getBlockProperties(snapshot.blocks[next]).solid) continue;
+                visited[next] = 1;
+                stack.push_back(next);
+            }
+        }
+        
+        for (int a = 0; a < FACE_COUNT; a++) {
+            if (!(faces & (1 << a))) continue;
+            for (int b = 0; b < FACE_COUNT; b++) {
+                if (faces & (1 << b)) connectivity |= faceConnectionBit(a, b);
+            }
+        }
+        if (connectivity == ALL_FACES_CONNECTED) break;
+    }
+    
+    return connectivity;
+}
+
+void ChunkMesher::buildMesh(const ChunkSnapshot& snapshot, ChunkMeshData& out) {
+    out.clear();
+    out.lod = snapshot.lod;
+    out.faceConnectivity = computeFaceConnectivity(snapshot);
+    if (snapshot.minY >= snapshot.maxY) return;
+    LayeredVertices layered;
+    if (snapshot.lod > 0) {
+        buildLodMesh(snapshot, layered);
+        layered.moveInto(out);
+        return;
+    }
+    
+    const BlockType* blocks = snapshot.blocks.data();
+    const uint8_t* light = snapshot.light.data();
+    bool ambientOcclusion = snapshot.ambientOcclusion;
+    int minY = snapshot.minY;
+    int maxY = snapshot.maxY;
+    
+    int lo[3] = { 0, minY, 0 };
+    int hi[3] = { CHUNK_WIDTH, maxY, CHUNK_DEPTH };
+    std::vector<FaceKey> mask;
+    
+    // Face culling is done a whole column at a time with the snapshot's bitmasks;
+    // the slice loop below only has to test one bit per cell
+    std::vector<ColumnMask> visible;
+    computeVisibleFaces(snapshot, visible);
+    
+    for (int face = 0; face < 6; face++) {
+        int n = FACE_AXIS[face];
+        int a = (n + 1) % 3; // Mask rows
+        int b = (n + 2) % 3; // Mask columns
+        int widthA = hi[a] - lo[a];
+        int widthB = hi[b] - lo[b];
+        mask.assign(widthA * widthB, NO_FACE);
+        const ColumnMask* faceVisible = &visible[face * CHUNK_WIDTH * CHUNK_DEPTH];
+        int neighbourOffset = ChunkSnapshot::faceOffset(face);
+        
+        // Every column's visible cells OR'd together, so empty y slices are skipped outright
+        ColumnMask anyColumn = ColumnMask();
+        for (int column = 0; column < CHUNK_WIDTH * CHUNK_DEPTH; column++) {
+            for (int w = 0; w < COLUMN_WORDS; w++) {
+                anyColumn.words[w] |= faceVisible[column].words[w];
+            }
+        }
+        
+        for (int d = lo[n]; d < hi[n]; d++) {
+            bool sliceHasFaces = false;
+            if (n == 1) {
+                sliceHasFaces = anyColumn.test(d);
+            } else {
+                for (int k = 0; k < CHUNK_SIZE[2 - n] && !sliceHasFaces; k++) {
+                    sliceHasFaces = faceVisible[n == 0 ? d * CHUNK_DEPTH + k : k * CHUNK_DEPTH + d].any();
+                }
+            }
+            if (!sliceHasFaces) continue;
+            
+            // Mark the visible faces in this slice
+            int p[3];
+            p[n] = d;
+            for (int j = 0; j < widthB; j++) {
+                for (int i = 0; i < widthA; i++) {
+                    p[a] = lo[a] + i;
+                    p[b] = lo[b] + j;
+                    bool shown = faceVisible[p[0] * CHUNK_DEPTH + p[2]].test(p[1]);
+                    if (!shown) {
+                        mask[j * widthA + i] = NO_FACE;
+                        continue;
+                    }
+                    // Only same-type translucent neighbours are left to check
+                    int index = ChunkSnapshot::paddedIndex(p[0], p[1], p[2]);
+                    int front = index + neighbourOffset;
+                    BlockType type = blocks[index];
+                    if (blocks[front] == type && OCCLUDERS.hidesSameType[type]) {
+                        mask[j * widthA + i] = NO_FACE;
+                        continue;
+                    }
+                    uint8_t occlusion = ambientOcclusion ? faceOcclusion(blocks, front, face) : UNOCCLUDED;
+                    mask[j * widthA + i] = makeFaceKey(type, light[front], occlusion);
+                }
+            }
+            
+            int base[3];
+            base[n] = d;
+            base[a] = lo[a];
+            base[b] = lo[b];
+            emitSlice(layered, face, mask.data(), widthA, widthB, base, 1);
+        }
+    }
+    layered.moveInto(out);
+}
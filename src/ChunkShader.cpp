@@ -0,0 +1,180 @@
+#include "ChunkShader.h"
+#include <iostream>
+#include <vector>
+#include "Block.h"
+#include "ChunkMesher.h"
+
+namespace {
+
+// Length of the blockColors uniform array in VERTEX_SOURCE
+const int MAX_BLOCK_COLORS = 16;
+static_assert(BLOCK_TYPE_COUNT <= MAX_BLOCK_COLORS, "Grow blockColors in the chunk vertex shader");
+
+const char* VERTEX_SOURCE =
+    "#version 120\n"
+    "attribute vec4 position;\n" // Chunk-local x, y, z and atlas tile
+    "attribute vec4 info;\n"     // Face, ambient occlusion, packed light
+    "attribute vec3 chunkOrigin;\n" // Per draw, see ChunkDrawList
+    "uniform vec3 faceU[6];\n"
+    "uniform vec3 faceV[6];\n"
+    "uniform vec3 blockColors[16];\n" // MAX_BLOCK_COLORS
+    "varying vec3 tileCoord;\n"
+    "varying vec3 color;\n"
+    "varying float shade;\n"
+    "void main() {\n"
+    "    int face = int(info.x);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(chunkOrigin + position.xyz, 1.0);\n"
+    "    tileCoord = vec3(dot(position.xyz, faceU[face]), dot(position.xyz, faceV[face]), position.w);\n"
+    "    float sky = floor(info.z / 16.0);\n"
+    "    float block = info.z - sky * 16.0;\n"
+    "    float light = max(sky, block) / 15.0;\n"
+    "    float ao = info.y / 3.0;\n"
+    "    shade = (0.25 + 0.75 * light) * (0.5 + 0.5 * ao);\n"
+    "    color = blockColors[int(position.w)];\n"
+    "}\n";
+
+const char* FRAGMENT_SOURCE =
+    "#version 120\n"
+    "uniform sampler2D atlas;\n"
+    "uniform float tilesPerRow;\n"
+    "uniform int shading;\n" // ChunkShading
+    "uniform float layerAlpha;\n"
+    "varying vec3 tileCoord;\n"
+    "varying vec3 color;\n"
+    "varying float shade;\n"
+    "void main() {\n"
+    "    vec4 result;\n"
+    "    if (shading == 2) {\n"
+    "        result = vec4(1.0);\n"
+    "    } else if (shading == 1) {\n"
+    "        result = vec4(color * shade, 1.0);\n"
+    "    } else {\n"
+    "        vec2 tile = vec2(mod(tileCoord.z, tilesPerRow), floor(tileCoord.z / tilesPerRow));\n"
+    "        vec2 uv = (tile + fract(tileCoord.xy)) / tilesPerRow;\n"
+    "        vec4 texel = texture2D(atlas, uv);\n"
+    "        result = vec4(texel.rgb * shade, texel.a);\n"
+    "    }\n"
+    "    gl_FragColor = vec4(result.rgb, result.a * layerAlpha);\n"
+    "}\n";
+
+// Blend alpha per render layer
+const float LAYER_ALPHA[RENDER_LAYER_COUNT] = { 1.0f, 0.6f };
+
+} // namespace
+
+ChunkShader::ChunkShader() : program(0), atlasLocation(-1), tilesPerRowLocation(-1), shadingLocation(-1),
+    layerAlphaLocation(-1) {
+}
+
+ChunkShader::~ChunkShader() {
+    if (program != 0) {
+        glDeleteProgram(program);
+    }
+}
+
+GLuint ChunkShader::compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        GLint logLength = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+        std::vector<char> log(logLength + 1, '\0');
+        glGetShaderInfoLog(shader, logLength, nullptr, log.data());
+        std::cout << "Chunk shader compile failed: " << log.data() << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool ChunkShader::init(int atlasTilesPerRow) {
+    const char* version = (const char*)glGetString(GL_SHADING_LANGUAGE_VERSION);
+    if (!version) {
+        std::cout << "GLSL not available - chunk meshes cannot be drawn" << std::endl;
+        return false;
+    }
+    
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, VERTEX_SOURCE);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, FRAGMENT_SOURCE);
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return false;
+    }
+    
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glBindAttribLocation(program, POSITION_ATTRIBUTE, "position");
+    glBindAttribLocation(program, INFO_ATTRIBUTE, "info");
+    glBindAttribLocation(program, ORIGIN_ATTRIBUTE, "chunkOrigin");
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        GLint logLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+        std::vector<char> log(logLength + 1, '\0');
+        glGetProgramInfoLog(program, logLength, nullptr, log.data());
+        std::cout << "Chunk shader link failed: " << log.data() << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+    
+    atlasLocation = glGetUniformLocation(program, "atlas");
+    tilesPerRowLocation = glGetUniformLocation(program, "tilesPerRow");
+    shadingLocation = glGetUniformLocation(program, "shading");
+    layerAlphaLocation = glGetUniformLocation(program, "layerAlpha");
+    
+    // Per-face texture axes and per-type colours never change, so they are set once
+    GLfloat faceU[6 * 3], faceV[6 * 3];
+    for (int face = 0; face < 6; face++) {
+        int uAxis[3], vAxis[3];
+        ChunkMesher::getFaceTextureAxes(face, uAxis, vAxis);
+        for (int axis = 0; axis < 3; axis++) {
+            faceU[face * 3 + axis] = (GLfloat)uAxis[axis];
+            faceV[face * 3 + axis] = (GLfloat)vAxis[axis];
+        }
+    }
+    GLfloat blockColors[MAX_BLOCK_COLORS * 3] = {};
+    for (int type = 0; type < BLOCK_TYPE_COUNT; type++) {
+        for (int channel = 0; channel < 3; channel++) {
+            blockColors[type * 3 + channel] = BLOCK_PROPERTIES[type].color[channel];
+        }
+    }
+    
+    glUseProgram(program);
+    glUniform1i(atlasLocation, 0);
+    glUniform1f(tilesPerRowLocation, (float)atlasTilesPerRow);
+    glUniform3fv(glGetUniformLocation(program, "faceU"), 6, faceU);
+    glUniform3fv(glGetUniformLocation(program, "faceV"), 6, faceV);
+    glUniform3fv(glGetUniformLocation(program, "blockColors"), MAX_BLOCK_COLORS, blockColors);
+    glUseProgram(0);
+    
+    std::cout << "Chunk shader ready (GLSL " << version << ")" << std::endl;
+    return true;
+}
+
+void ChunkShader::bind(GLuint atlasTexture, ChunkShading shading) const {
+    glUseProgram(program);
+    glUniform1i(shadingLocation, (GLint)shading);
+    setLayer(RenderLayer::SOLID);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+}
+
+void ChunkShader::setLayer(RenderLayer layer) const {
+    glUniform1f(layerAlphaLocation, LAYER_ALPHA[(int)layer]);
+}
+
+void ChunkShader::unbind() const {
+    glUseProgram(0);
+}
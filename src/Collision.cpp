@@ -0,0 +1,73 @@
+#include "Collision.h"
+#include "World.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+// Faces closer than this count as touching, not overlapping, so a box resting
+// exactly on a block doesn't see it as part of its own cross-section
+const float TOUCH_EPSILON = 1e-4f;
+
+} // namespace
+
+AABB AABB::standingAt(const Vector3& base, float halfWidth, float height) {
+    return { { base.x - halfWidth, base.y, base.z - halfWidth },
+             { base.x + halfWidth, base.y + height, base.z + halfWidth } };
+}
+
+bool VoxelCollider::isSlabSolid(const AABB& box, int axis, int cell) const {
+    int a = (axis + 1) % 3;
+    int b = (axis + 2) % 3;
+    int minA = (int)std::floor(box.min[a] + TOUCH_EPSILON);
+    int maxA = (int)std::ceil(box.max[a] - TOUCH_EPSILON) - 1;
+    int minB = (int)std::floor(box.min[b] + TOUCH_EPSILON);
+    int maxB = (int)std::ceil(box.max[b] - TOUCH_EPSILON) - 1;
+    
+    int p[3];
+    p[axis] = cell;
+    for (p[a] = minA; p[a] <= maxA; p[a]++) {
+        for (p[b] = minB; p[b] <= maxB; p[b]++) {
+            if (world.isBlockSolidAt(p[0], p[1], p[2])) return true;
+        }
+    }
+    return false;
+}
+
+float VoxelCollider::sweepAxis(const AABB& box, int axis, float distance) const {
+    if (distance > 0.0f) {
+        // Cells ahead of the leading face, up to where it ends
+        int first = (int)std::ceil(box.max[axis] - TOUCH_EPSILON);
+        int last = (int)std::ceil(box.max[axis] + distance) - 1;
+        for (int cell = first; cell <= last; cell++) {
+            if (isSlabSolid(box, axis, cell)) {
+                return std::max(0.0f, cell - box.max[axis]);
+            }
+        }
+    } else if (distance < 0.0f) {
+        int first = (int)std::floor(box.min[axis] + TOUCH_EPSILON) - 1;
+        int last = (int)std::floor(box.min[axis] + distance);
+        for (int cell = first; cell >= last; cell--) {
+            if (isSlabSolid(box, axis, cell)) {
+                return std::min(0.0f, cell + 1 - box.min[axis]);
+            }
+        }
+    }
+    return distance;
+}
+
+CollisionResult VoxelCollider::move(AABB& box, const Vector3& motion) const {
+    // Vertical first, so landing is settled before sliding along the ground
+    static const int AXIS_ORDER[3] = { 1, 0, 2 };
+    const float wanted[3] = { motion.x, motion.y, motion.z };
+    float moved[3] = { 0.0f, 0.0f, 0.0f };
+    
+    CollisionResult result;
+    for (int axis : AXIS_ORDER) {
+        moved[axis] = sweepAxis(box, axis, wanted[axis]);
+        box.translate(axis, moved[axis]);
+        result.hit[axis] = moved[axis] != wanted[axis];
+    }
+    result.motion = Vector3(moved[0], moved[1], moved[2]);
+    return result;
+}
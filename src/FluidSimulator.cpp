@@ -0,0 +1,131 @@
+#include "FluidSimulator.h"
+#include "World.h"
+#include <algorithm>
+
+namespace {
+
+const int UP = 2;   // Face index of +y
+const int DOWN = 3; // Face index of -y
+
+BlockPos offset(const BlockPos& pos, int face) {
+    return { pos.x + FACE_DIRECTIONS[face][0], pos.y + FACE_DIRECTIONS[face][1], pos.z + FACE_DIRECTIONS[face][2] };
+}
+
+} // namespace
+
+FluidSimulator::FluidSimulator(World& world) : world(world), currentTick(0), nextOrder(0), lastUpdates(0) {
+}
+
+int FluidSimulator::getLevel(const BlockPos& pos) {
+    if (world.getBlockAt(pos.x, pos.y, pos.z).type != BlockType::WATER) return NO_WATER;
+    auto it = flowLevels.find(pos);
+    return it != flowLevels.end() ? it->second : SOURCE;
+}
+
+int FluidSimulator::desiredLevel(const BlockPos& pos, int current) {
+    if (current == SOURCE) return SOURCE;
+    if (current == NO_WATER && world.getBlockAt(pos.x, pos.y, pos.z).type != BlockType::AIR) return NO_WATER;
+    
+    if (getLevel(offset(pos, UP)) != NO_WATER) return FALLING;
+    
+    // Water spreads sideways only where it rests on something: on a block or on
+    // a source, not in mid-fall or on top of other flowing water
+    int best = NO_WATER;
+    for (int face = 0; face < FACE_COUNT; face++) {
+        if (face == UP || face == DOWN) continue;
+        BlockPos from = offset(pos, face);
+        int level = getLevel(from);
+        if (level == NO_WATER) continue;
+        
+        BlockPos below = offset(from, DOWN);
+        BlockType belowType = world.getBlockAt(below.x, below.y, below.z).type;
+        if (belowType == BlockType::AIR || (belowType == BlockType::WATER && getLevel(below) != SOURCE)) continue;
+        
+        int spread = (level == FALLING) ? 1 : level + 1;
+        if (spread <= MAX_FLOW && (best == NO_WATER || spread < best)) {
+            best = spread;
+        }
+    }
+    return best;
+}
+
+void FluidSimulator::schedule(const BlockPos& pos, int delay) {
+    if (!pending.insert(pos).second) return;
+    scheduled.push({ currentTick + delay, nextOrder++, pos });
+}
+
+void FluidSimulator::scheduleAround(const BlockPos& pos, int delay) {
+    schedule(pos, delay);
+    for (int face = 0; face < FACE_COUNT; face++) {
+        schedule(offset(pos, face), delay);
+    }
+}
+
+void FluidSimulator::blockChanged(int x, int y, int z) {
+    BlockPos pos = { x, y, z };
+    flowLevels.erase(pos);
+    
+    // Only water next to the change can move; anything else stays asleep
+    bool nearWater = world.getBlockAt(x, y, z).type == BlockType::WATER;
+    for (int face = 0; face < FACE_COUNT && !nearWater; face++) {
+        BlockPos next = offset(pos, face);
+        nearWater = world.getBlockAt(next.x, next.y, next.z).type == BlockType::WATER;
+    }
+    if (nearWater) {
+        scheduleAround(pos, FLOW_DELAY);
+    }
+}
+
+void FluidSimulator::apply(const BlockPos& pos, int current, int desired) {
+    if (desired == NO_WATER) {
+        world.setBlockAt(pos.x, pos.y, pos.z, Block(BlockType::AIR));
+    } else if (current == NO_WATER) {
+        world.setBlockAt(pos.x, pos.y, pos.z, Block(BlockType::WATER));
+    }
+    // After setBlockAt, which treats the change as an edit and clears the level
+    if (desired != NO_WATER) {
+        flowLevels[pos] = (uint8_t)desired;
+    }
+    scheduleAround(pos, FLOW_DELAY);
+}
+
+void FluidSimulator::tick() {
+    currentTick++;
+    
+    // Every due cell decides from the world as it was at the start of the tick,
+    // then all of them change together, so water moves one cell per update
+    // rather than running down a whole channel in queue order
+    changes.clear();
+    lastUpdates = 0;
+    while (!scheduled.empty() && scheduled.top().tick <= currentTick && lastUpdates < MAX_UPDATES_PER_TICK) {
+        BlockPos pos = scheduled.top().pos;
+        scheduled.pop();
+        pending.erase(pos);
+        lastUpdates++;
+        
+        // Water stops at the edge of the loaded world
+        if (!world.getChunkAt(blockToChunkX(pos.x), blockToChunkY(pos.y), blockToChunkZ(pos.z))) continue;
+        int current = getLevel(pos);
+        int desired = desiredLevel(pos, current);
+        if (desired != current) {
+            changes.push_back({ pos, current, desired });
+        }
+    }
+    for (const Change& change : changes) {
+        apply(change.pos, change.current, change.desired);
+    }
+}
+
+void FluidSimulator::dropUnloaded() {
+    auto loaded = [this](const BlockPos& pos) {
+        return world.getChunkAt(blockToChunkX(pos.x), blockToChunkY(pos.y), blockToChunkZ(pos.z)) != nullptr;
+    };
+    for (auto it = flowLevels.begin(); it != flowLevels.end();) {
+        if (!loaded(it->first)) {
+            it = flowLevels.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Queued ticks for unloaded cells are skipped when they come due
+}
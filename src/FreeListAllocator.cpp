@@ -0,0 +1,70 @@
+#include "FreeListAllocator.h"
+#include <algorithm>
+#include <iterator>
+
+FreeListAllocator::FreeListAllocator(uint32_t capacity) : capacity(0), used(0) {
+    reset(capacity);
+}
+
+uint32_t FreeListAllocator::allocate(uint32_t size) {
+    if (size == 0) return INVALID_OFFSET;
+    
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+        if (it->second < size) continue;
+        
+        uint32_t offset = it->first;
+        uint32_t remaining = it->second - size;
+        freeBlocks.erase(it);
+        if (remaining > 0) {
+            freeBlocks[offset + size] = remaining;
+        }
+        used += size;
+        return offset;
+    }
+    return INVALID_OFFSET;
+}
+
+void FreeListAllocator::free(uint32_t offset, uint32_t size) {
+    if (size == 0) return;
+    used -= size;
+    
+    // Merge with the free block that ends where this one starts, and the one
+    // that starts where this one ends
+    auto next = freeBlocks.lower_bound(offset);
+    if (next != freeBlocks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            freeBlocks.erase(prev);
+        }
+    }
+    if (next != freeBlocks.end() && offset + size == next->first) {
+        size += next->second;
+        freeBlocks.erase(next);
+    }
+    freeBlocks[offset] = size;
+}
+
+void FreeListAllocator::reset(uint32_t newCapacity, uint32_t usedPrefix) {
+    capacity = newCapacity;
+    used = std::min(usedPrefix, newCapacity);
+    freeBlocks.clear();
+    if (used < capacity) {
+        freeBlocks[used] = capacity - used;
+    }
+}
+
+uint32_t FreeListAllocator::getLargestFreeBlock() const {
+    uint32_t largest = 0;
+    for (const auto& block : freeBlocks) {
+        largest = std::max(largest, block.second);
+    }
+    return largest;
+}
+
+float FreeListAllocator::getFragmentation() const {
+    uint32_t freeSpace = getFree();
+    if (freeSpace == 0) return 0.0f;
+    return 1.0f - (float)getLargestFreeBlock() / freeSpace;
+}
@@ -0,0 +1,56 @@
+#include "Frustum.h"
+#include <cmath>
+
+Frustum::Frustum() {
+    // Until extracted, accept everything
+    for (int i = 0; i < 6; i++) {
+        planes[i][0] = planes[i][1] = planes[i][2] = 0.0f;
+        planes[i][3] = 1.0f;
+    }
+}
+
+void Frustum::extract(const float projection[16], const float modelview[16]) {
+    // clip = projection * modelview (column-major)
+    float clip[16];
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += projection[k * 4 + row] * modelview[col * 4 + k];
+            }
+            clip[col * 4 + row] = sum;
+        }
+    }
+    
+    // Gribb/Hartmann: each plane is the w row plus or minus the x, y or z row
+    for (int i = 0; i < 6; i++) {
+        int axisRow = i / 2;
+        float sign = (i % 2 == 0) ? 1.0f : -1.0f; // left/bottom/near, then right/top/far
+        for (int j = 0; j < 4; j++) {
+            planes[i][j] = clip[j * 4 + 3] + sign * clip[j * 4 + axisRow];
+        }
+        
+        float length = std::sqrt(planes[i][0] * planes[i][0] +
+                                 planes[i][1] * planes[i][1] +
+                                 planes[i][2] * planes[i][2]);
+        if (length > 0.0f) {
+            for (int j = 0; j < 4; j++) {
+                planes[i][j] /= length;
+            }
+        }
+    }
+}
+
+bool Frustum::intersectsBox(const Vector3& min, const Vector3& max) const {
+    for (int i = 0; i < 6; i++) {
+        // Corner of the box furthest along the plane normal
+        float px = planes[i][0] >= 0.0f ? max.x : min.x;
+        float py = planes[i][1] >= 0.0f ? max.y : min.y;
+        float pz = planes[i][2] >= 0.0f ? max.z : min.z;
+        
+        if (planes[i][0] * px + planes[i][1] * py + planes[i][2] * pz + planes[i][3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
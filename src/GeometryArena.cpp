@@ -0,0 +1,126 @@
+#include "GeometryArena.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Defragment once free space is split into this many blocks and most of it is
+// outside the largest one
+const int DEFRAGMENT_MIN_FREE_BLOCKS = 64;
+const float DEFRAGMENT_MIN_FRAGMENTATION = 0.5f;
+
+} // namespace
+
+GeometryArena::GeometryArena() : buffer(0), relocationCount(0) {
+}
+
+GeometryArena::~GeometryArena() {
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer);
+    }
+}
+
+int GeometryArena::allocate(const std::vector<ChunkVertex>& vertices) {
+    uint32_t count = (uint32_t)vertices.size();
+    if (count == 0) return INVALID_HANDLE;
+    
+    uint32_t first = allocator.allocate(count);
+    if (first == FreeListAllocator::INVALID_OFFSET) {
+        // Enough space in total means it is only fragmented; otherwise grow
+        uint32_t capacity = allocator.getCapacity() > 0 ? allocator.getCapacity() : INITIAL_CAPACITY;
+        while (capacity - allocator.getUsed() < count) {
+            capacity *= 2;
+        }
+        relocate(capacity);
+        first = allocator.allocate(count);
+    }
+    
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = (int)ranges.size();
+        ranges.push_back(Range());
+    }
+    ranges[handle] = { first, count, true };
+    
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)first * sizeof(ChunkVertex), count * sizeof(ChunkVertex),
+                    vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return handle;
+}
+
+void GeometryArena::release(int handle) {
+    if (handle < 0 || handle >= (int)ranges.size() || !ranges[handle].live) return;
+    
+    allocator.free(ranges[handle].first, ranges[handle].count);
+    ranges[handle].live = false;
+    freeHandles.push_back(handle);
+}
+
+void GeometryArena::defragmentIfNeeded() {
+    if (allocator.getFreeBlockCount() >= DEFRAGMENT_MIN_FREE_BLOCKS &&
+        allocator.getFragmentation() > DEFRAGMENT_MIN_FRAGMENTATION) {
+        relocate(allocator.getCapacity());
+    }
+}
+
+void GeometryArena::relocate(uint32_t newCapacity) {
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)newCapacity * sizeof(ChunkVertex), nullptr, GL_DYNAMIC_DRAW);
+    
+    uint32_t packed = 0;
+    if (buffer != 0) {
+        std::vector<int> live;
+        for (int handle = 0; handle < (int)ranges.size(); handle++) {
+            if (ranges[handle].live) live.push_back(handle);
+        }
+        std::sort(live.begin(), live.end(), [this](int a, int b) {
+            return ranges[a].first < ranges[b].first;
+        });
+        
+        // Ranges that already sit back to back are moved with a single copy
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        uint32_t runSource = 0, runTarget = 0, runLength = 0;
+        auto copyRun = [&]() {
+            const GLsizeiptr vertexSize = sizeof(ChunkVertex);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, runSource * vertexSize,
+                                runTarget * vertexSize, runLength * vertexSize);
+        };
+        for (int handle : live) {
+            Range& range = ranges[handle];
+            if (runLength > 0 && range.first != runSource + runLength) {
+                copyRun();
+                runLength = 0;
+            }
+            if (runLength == 0) {
+                runSource = range.first;
+                runTarget = packed;
+            }
+            runLength += range.count;
+            range.first = packed;
+            packed += range.count;
+        }
+        if (runLength > 0) {
+            copyRun();
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+        relocationCount++;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    
+    // Defragmenting runs between frames as columns stream in and out, and the
+    // debug overlay already counts it; only growth is worth a log line
+    bool grew = newCapacity > allocator.getCapacity();
+    buffer = newBuffer;
+    allocator.reset(newCapacity, packed);
+    if (grew) {
+        std::cout << "Geometry arena: " << (size_t)newCapacity * sizeof(ChunkVertex) / (1024 * 1024) << " MB, "
+                  << (size_t)packed * sizeof(ChunkVertex) / 1024 << " KB in use" << std::endl;
+    }
+}
@@ -0,0 +1,310 @@
+#include "LightEngine.h"
+#include <algorithm>
+
+namespace {
+
+const int UP = 2;   // Face index of +y
+const int DOWN = 3; // Face index of -y
+
+const int HORIZONTAL_FACES[4] = { 0, 1, 4, 5 };
+
+int opacityAt(const Chunk* chunk, int x, int y, int z) {
+    return getBlockProperties(chunk->getBlockUnchecked(x, y, z).type).lightOpacity;
+}
+
+constexpr bool anyBlockEmitsLight() {
+    for (int type = 0; type < BLOCK_TYPE_COUNT; type++) {
+        if (BLOCK_PROPERTIES[type].lightEmission > 0) return true;
+    }
+    return false;
+}
+
+// Lowest y, counted from the bottom of the column, that sees the sky straight
+// up: the cell above the highest block with any opacity
+int skyHeight(Chunk* const* column, int height, int x, int z) {
+    for (int cy = height - 1; cy >= 0; cy--) {
+        const Chunk* chunk = column[cy];
+        for (int s = CHUNK_SECTIONS - 1; s >= 0; s--) {
+            if (chunk->isSectionEmpty(s)) continue;
+            for (int y = s * SECTION_SIZE + SECTION_SIZE - 1; y >= s * SECTION_SIZE; y--) {
+                if (opacityAt(chunk, x, y, z) > 0) {
+                    return cy * CHUNK_HEIGHT + y + 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// The column across a horizontal face, or false if any of it isn't loaded
+bool neighbourColumn(Chunk* const* column, int height, int face, std::vector<Chunk*>& out) {
+    out.resize(height);
+    for (int cy = 0; cy < height; cy++) {
+        out[cy] = column[cy]->getNeighbour(face);
+        if (!out[cy]) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int LightEngine::getLevel(const LightNode& node, Channel channel) {
+    uint8_t light = node.chunk->getLight(node.x, node.y, node.z);
+    return channel == Channel::SKY ? getSkyLight(light) : getBlockLight(light);
+}
+
+void LightEngine::setLevel(const LightNode& node, Channel channel, int level) {
+    Chunk* chunk = node.chunk;
+    uint8_t light = chunk->getLight(node.x, node.y, node.z);
+    if (channel == Channel::SKY) {
+        light = (uint8_t)((light & MAX_LIGHT) | (level << SKY_LIGHT_SHIFT));
+    } else {
+        light = (uint8_t)((light & ~MAX_LIGHT) | level);
+    }
+    chunk->setLight(node.x, node.y, node.z, light);
+    
+    // Faces are lit by the cell in front of them, so a border cell is also part
+    // of the neighbouring chunk's mesh
+    chunk->markDirty();
+    Chunk* neighbours[3] = {
+        node.x == 0 ? chunk->getNeighbour(5) : (node.x == CHUNK_WIDTH - 1 ? chunk->getNeighbour(4) : nullptr),
+        node.y == 0 ? chunk->getNeighbour(3) : (node.y == CHUNK_HEIGHT - 1 ? chunk->getNeighbour(2) : nullptr),
+        node.z == 0 ? chunk->getNeighbour(0) : (node.z == CHUNK_DEPTH - 1 ? chunk->getNeighbour(1) : nullptr)
+    };
+    for (Chunk* neighbour : neighbours) {
+        if (neighbour) neighbour->markDirty();
+    }
+}
+
+bool LightEngine::step(const LightNode& from, int face, LightNode& to) {
+    int x = from.x + FACE_DIRECTIONS[face][0];
+    int y = from.y + FACE_DIRECTIONS[face][1];
+    int z = from.z + FACE_DIRECTIONS[face][2];
+    Chunk* chunk = from.chunk;
+    if (!Chunk::inBounds(x, y, z)) {
+        chunk = chunk->getNeighbour(face);
+        if (!chunk) return false;
+    }
+    to.chunk = chunk;
+    to.x = (uint8_t)blockToLocalX(x);
+    to.y = (uint8_t)blockToLocalY(y);
+    to.z = (uint8_t)blockToLocalZ(z);
+    to.level = 0;
+    return true;
+}
+
+void LightEngine::propagate(Channel channel) {
+    for (size_t i = 0; i < addQueue.size(); i++) {
+        LightNode node = addQueue[i]; // Copied: pushing may reallocate
+        int level = getLevel(node, channel);
+        if (level <= 1) continue;
+        
+        for (int face = 0; face < FACE_COUNT; face++) {
+            LightNode next;
+            if (!step(node, face, next)) continue;
+            int opacity = opacityAt(next.chunk, next.x, next.y, next.z);
+            if (opacity >= MAX_LIGHT) continue;
+            
+            bool skyColumn = channel == Channel::SKY && face == DOWN && level == MAX_LIGHT && opacity == 0;
+            int spread = skyColumn ? MAX_LIGHT : level - 1 - opacity;
+            if (spread > getLevel(next, channel)) {
+                setLevel(next, channel, spread);
+                addQueue.push_back(next);
+            }
+        }
+    }
+    addQueue.clear();
+}
+
+void LightEngine::unpropagate(Channel channel) {
+    for (size_t i = 0; i < removeQueue.size(); i++) {
+        LightNode node = removeQueue[i];
+        
+        for (int face = 0; face < FACE_COUNT; face++) {
+            LightNode next;
+            if (!step(node, face, next)) continue;
+            int level = getLevel(next, channel);
+            if (level == 0) continue;
+            
+            // Dimmer neighbours may have been lit through this cell (as may the
+            // full skylight column below it); brighter ones are lit from
+            // elsewhere and refill the darkened region afterwards
+            bool litFromHere = level < node.level ||
+                               (channel == Channel::SKY && face == DOWN && node.level == MAX_LIGHT &&
+                                level == MAX_LIGHT);
+            if (!litFromHere) {
+                addQueue.push_back(next);
+                continue;
+            }
+            setLevel(next, channel, 0);
+            next.level = (uint8_t)level;
+            removeQueue.push_back(next);
+            
+            int emission = channel == Channel::BLOCK ?
+                getBlockProperties(next.chunk->getBlockUnchecked(next.x, next.y, next.z).type).lightEmission : 0;
+            if (emission > 0) {
+                setLevel(next, channel, emission);
+                addQueue.push_back(next);
+            }
+        }
+    }
+    removeQueue.clear();
+}
+
+void LightEngine::relight(const LightNode& cell, Channel channel, int emission) {
+    LightNode node = cell;
+    node.level = (uint8_t)getLevel(node, channel);
+    if (node.level > 0) {
+        setLevel(node, channel, 0);
+        removeQueue.push_back(node);
+    }
+    unpropagate(channel);
+    
+    // Refill the cell from its own emission, the open sky at the top of the
+    // world, and whatever light its neighbours hold
+    int level = emission;
+    if (channel == Channel::SKY && node.y == CHUNK_HEIGHT - 1 && !node.chunk->getNeighbour(UP) &&
+        opacityAt(node.chunk, node.x, node.y, node.z) == 0) {
+        level = MAX_LIGHT;
+    }
+    if (level > 0) {
+        setLevel(node, channel, level);
+        addQueue.push_back(node);
+    }
+    for (int face = 0; face < FACE_COUNT; face++) {
+        LightNode next;
+        if (step(node, face, next) && getLevel(next, channel) > 0) {
+            addQueue.push_back(next);
+        }
+    }
+    propagate(channel);
+}
+
+void LightEngine::lightColumn(Chunk* const* column, int height) {
+    const int columnHeight = height * CHUNK_HEIGHT;
+    auto nodeAt = [&](Chunk* const* chunks, int x, int y, int z) {
+        LightNode node = { chunks[y / CHUNK_HEIGHT], (uint8_t)x, (uint8_t)(y % CHUNK_HEIGHT), (uint8_t)z, 0 };
+        return node;
+    };
+    
+    // Full skylight down to the first block in each x/z column and dark below.
+    // Sections wholly above or below the surface are set without per-cell storage.
+    int heights[CHUNK_WIDTH * CHUNK_DEPTH];
+    int lowest = columnHeight;
+    int highest = 0;
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int z = 0; z < CHUNK_DEPTH; z++) {
+            int h = skyHeight(column, height, x, z);
+            heights[x * CHUNK_DEPTH + z] = h;
+            lowest = std::min(lowest, h);
+            highest = std::max(highest, h);
+        }
+    }
+    for (int cy = 0; cy < height; cy++) {
+        Chunk* chunk = column[cy];
+        for (int s = 0; s < CHUNK_SECTIONS; s++) {
+            int bottom = cy * CHUNK_HEIGHT + s * SECTION_SIZE;
+            if (bottom >= highest) {
+                chunk->fillSectionLight(s, FULL_SKY_LIGHT);
+                continue;
+            }
+            chunk->fillSectionLight(s, 0);
+            if (bottom + SECTION_SIZE <= lowest) continue;
+            
+            for (int x = 0; x < CHUNK_WIDTH; x++) {
+                for (int z = 0; z < CHUNK_DEPTH; z++) {
+                    int h = heights[x * CHUNK_DEPTH + z];
+                    for (int y = std::max(bottom, h); y < bottom + SECTION_SIZE; y++) {
+                        chunk->setLight(x, y % CHUNK_HEIGHT, z, FULL_SKY_LIGHT);
+                    }
+                }
+            }
+        }
+        chunk->markDirty();
+    }
+    
+    // Skylight spreads from the lowest lit cell of each x/z column down into
+    // water and leaves, and sideways from every lit cell beside a neighbouring
+    // column whose sky height is greater, inside this column or across its borders
+    std::vector<Chunk*> sides[4];
+    bool sideLoaded[4];
+    for (int i = 0; i < 4; i++) {
+        sideLoaded[i] = neighbourColumn(column, height, HORIZONTAL_FACES[i], sides[i]);
+    }
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int z = 0; z < CHUNK_DEPTH; z++) {
+            int h = heights[x * CHUNK_DEPTH + z];
+            int top = h + 1;
+            for (int i = 0; i < 4; i++) {
+                int face = HORIZONTAL_FACES[i];
+                int nx = x + FACE_DIRECTIONS[face][0];
+                int nz = z + FACE_DIRECTIONS[face][2];
+                if (nx >= 0 && nx < CHUNK_WIDTH && nz >= 0 && nz < CHUNK_DEPTH) {
+                    top = std::max(top, heights[nx * CHUNK_DEPTH + nz]);
+                } else if (sideLoaded[i]) {
+                    top = std::max(top, skyHeight(sides[i].data(), height, blockToLocalX(nx), blockToLocalZ(nz)));
+                }
+            }
+            for (int y = h; y < std::min(top, columnHeight); y++) {
+                addQueue.push_back(nodeAt(column, x, y, z));
+            }
+        }
+    }
+    
+    // Light already in the neighbouring columns flows in across the borders
+    auto seedFromBorders = [&](Channel channel) {
+        for (int i = 0; i < 4; i++) {
+            if (!sideLoaded[i]) continue;
+            int face = HORIZONTAL_FACES[i];
+            for (int k = 0; k < CHUNK_WIDTH; k++) {
+                int x = FACE_DIRECTIONS[face][0] == 0 ? k : (FACE_DIRECTIONS[face][0] > 0 ? CHUNK_WIDTH - 1 : 0);
+                int z = FACE_DIRECTIONS[face][2] == 0 ? k : (FACE_DIRECTIONS[face][2] > 0 ? CHUNK_DEPTH - 1 : 0);
+                int outsideX = blockToLocalX(x + FACE_DIRECTIONS[face][0]);
+                int outsideZ = blockToLocalZ(z + FACE_DIRECTIONS[face][2]);
+                // Cells at or above the sky height are already at full skylight
+                int end = channel == Channel::SKY ? heights[x * CHUNK_DEPTH + z] : columnHeight;
+                for (int y = 0; y < end; y++) {
+                    LightNode outside = nodeAt(sides[i].data(), outsideX, y, outsideZ);
+                    if (getLevel(outside, channel) > 1) {
+                        addQueue.push_back(outside);
+                    }
+                }
+            }
+        }
+    };
+    seedFromBorders(Channel::SKY);
+    propagate(Channel::SKY);
+    
+    // Block light from any light sources generation placed
+    if (anyBlockEmitsLight()) {
+        for (int cy = 0; cy < height; cy++) {
+            for (int s = 0; s < CHUNK_SECTIONS; s++) {
+                if (column[cy]->isSectionEmpty(s)) continue;
+                for (int x = 0; x < CHUNK_WIDTH; x++) {
+                    for (int z = 0; z < CHUNK_DEPTH; z++) {
+                        for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
+                            BlockType type = column[cy]->getBlockUnchecked(x, y, z).type;
+                            int emission = getBlockProperties(type).lightEmission;
+                            if (emission == 0) continue;
+                            LightNode node = { column[cy], (uint8_t)x, (uint8_t)y, (uint8_t)z, 0 };
+                            setLevel(node, Channel::BLOCK, emission);
+                            addQueue.push_back(node);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    seedFromBorders(Channel::BLOCK);
+    propagate(Channel::BLOCK);
+}
+
+void LightEngine::blockChanged(Chunk* chunk, int x, int y, int z, BlockType oldType, BlockType newType) {
+    const BlockProperties& before = getBlockProperties(oldType);
+    const BlockProperties& after = getBlockProperties(newType);
+    if (before.lightOpacity == after.lightOpacity && before.lightEmission == after.lightEmission) return;
+    
+    LightNode node = { chunk, (uint8_t)x, (uint8_t)y, (uint8_t)z, 0 };
+    relight(node, Channel::SKY, 0);
+    relight(node, Channel::BLOCK, after.lightEmission);
+}
@@ -0,0 +1,61 @@
+#include "MeshWorkerPool.h"
+#include <algorithm>
+
+MeshWorkerPool::MeshWorkerPool(int threadCount) : stopping(false), jobsInFlight(0) {
+    if (threadCount <= 0) {
+        // Leave a core for the GLUT thread
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    }
+    
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&MeshWorkerPool::workerLoop, this);
+    }
+}
+
+MeshWorkerPool::~MeshWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void MeshWorkerPool::submit(std::unique_ptr<ChunkSnapshot> snapshot) {
+    jobsInFlight.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobs.push_back(std::move(snapshot));
+    }
+    jobAvailable.notify_one();
+}
+
+bool MeshWorkerPool::pollResult(MeshResult& out) {
+    if (!results.pop(out)) return false;
+    
+    jobsInFlight.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MeshWorkerPool::workerLoop() {
+    for (;;) {
+        std::unique_ptr<ChunkSnapshot> snapshot;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            
+            snapshot = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        
+        MeshResult result;
+        result.coord = snapshot->coord;
+        result.revision = snapshot->revision;
+        ChunkMesher::buildMesh(*snapshot, result.mesh);
+        results.push(std::move(result));
+    }
+}
@@ -0,0 +1,191 @@
+#include "Noise.h"
+#include "Random.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NOISE_USE_SSE2 1
+#endif
+
+namespace {
+
+// Shift between octaves so their lattices never line up at the origin
+const float OCTAVE_OFFSET = 31.7f;
+
+inline float fade(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+inline float lerp(float t, float a, float b) {
+    return a + t * (b - a);
+}
+
+// Diagonal gradients (+-1, +-1): bit 0 flips x, bit 1 flips z
+inline float grad(int hash, float x, float z) {
+    return ((hash & 1) ? -x : x) + ((hash & 2) ? -z : z);
+}
+
+} // namespace
+
+Noise::Noise(uint64_t seed) {
+    CounterRandom rng(seed);
+    for (int i = 0; i < 256; i++) {
+        perm[i] = (uint8_t)i;
+    }
+    for (int i = 255; i > 0; i--) {
+        int j = rng.nextInt(i + 1);
+        uint8_t tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+    for (int i = 0; i < 256; i++) {
+        perm[256 + i] = perm[i];
+    }
+}
+
+float Noise::sampleOctave(float x, float z) const {
+    float fx = std::floor(x);
+    float fz = std::floor(z);
+    int X = (int)fx & 255;
+    int Z = (int)fz & 255;
+    float xf = x - fx;
+    float zf = z - fz;
+    float u = fade(xf);
+    float v = fade(zf);
+    
+    int h00 = perm[perm[X] + Z];
+    int h10 = perm[perm[X + 1] + Z];
+    int h01 = perm[perm[X] + Z + 1];
+    int h11 = perm[perm[X + 1] + Z + 1];
+    
+    float x0 = lerp(u, grad(h00, xf, zf), grad(h10, xf - 1.0f, zf));
+    float x1 = lerp(u, grad(h01, xf, zf - 1.0f), grad(h11, xf - 1.0f, zf - 1.0f));
+    return lerp(v, x0, x1);
+}
+
+float Noise::fractal(float x, float z, int octaves, float lacunarity, float gain) const {
+    float total = 0.0f;
+    float amplitude = 1.0f;
+    float frequency = 1.0f;
+    float amplitudeSum = 0.0f;
+    for (int o = 0; o < octaves; o++) {
+        float offset = o * OCTAVE_OFFSET;
+        total += amplitude * sampleOctave(x * frequency + offset, z * frequency + offset);
+        amplitudeSum += amplitude;
+        amplitude *= gain;
+        frequency *= lacunarity;
+    }
+    return total / amplitudeSum;
+}
+
+void Noise::fractalGrid(float originX, float originZ, float spacing, int octaves, float* out,
+                        float lacunarity, float gain) const {
+    float xs[GRID_SIZE], zs[GRID_SIZE];
+    for (int i = 0; i < GRID_SIZE; i++) {
+        xs[i] = originX + i * spacing;
+        zs[i] = originZ + i * spacing;
+    }
+
+#ifdef NOISE_USE_SSE2
+    // Each row shares one x, so the x lattice cell, x fade and first permutation
+    // lookup are scalar; the four z lanes of a row are evaluated together. Only
+    // the final permutation lookups are done per lane, since SSE2 has no gather.
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 six = _mm_set1_ps(6.0f);
+    const __m128 fifteen = _mm_set1_ps(15.0f);
+    const __m128 ten = _mm_set1_ps(10.0f);
+    const __m128i mask255 = _mm_set1_epi32(255);
+    
+    float amplitudeSum = 0.0f;
+    {
+        float amplitude = 1.0f;
+        for (int o = 0; o < octaves; o++) {
+            amplitudeSum += amplitude;
+            amplitude *= gain;
+        }
+    }
+    const __m128 amplitudeSumV = _mm_set1_ps(amplitudeSum);
+    
+    for (int i = 0; i < GRID_SIZE; i++) {
+        __m128 total[GRID_SIZE / 4];
+        for (int lane = 0; lane < GRID_SIZE / 4; lane++) {
+            total[lane] = _mm_setzero_ps();
+        }
+        
+        float amplitude = 1.0f;
+        float frequency = 1.0f;
+        for (int o = 0; o < octaves; o++) {
+            float offset = o * OCTAVE_OFFSET;
+            
+            float x = xs[i] * frequency + offset;
+            float fx = std::floor(x);
+            int X = (int)fx & 255;
+            float xf = x - fx;
+            float u = fade(xf);
+            int rowA = perm[X];
+            int rowB = perm[X + 1];
+            
+            const __m128 xfV = _mm_set1_ps(xf);
+            const __m128 xf1V = _mm_set1_ps(xf - 1.0f);
+            const __m128 uV = _mm_set1_ps(u);
+            const __m128 frequencyV = _mm_set1_ps(frequency);
+            const __m128 offsetV = _mm_set1_ps(offset);
+            const __m128 amplitudeV = _mm_set1_ps(amplitude);
+            
+            for (int lane = 0; lane < GRID_SIZE / 4; lane++) {
+                __m128 z = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(zs + lane * 4), frequencyV), offsetV);
+                
+                // floor(z): truncate, then step down where truncation rounded up
+                __m128i zi = _mm_cvttps_epi32(z);
+                __m128 fz = _mm_cvtepi32_ps(zi);
+                __m128 roundedUp = _mm_cmpgt_ps(fz, z);
+                fz = _mm_sub_ps(fz, _mm_and_ps(roundedUp, one));
+                zi = _mm_add_epi32(zi, _mm_castps_si128(roundedUp));
+                
+                __m128 zf = _mm_sub_ps(z, fz);
+                __m128 zf1 = _mm_sub_ps(zf, one);
+                __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(zf, zf), zf),
+                                      _mm_add_ps(_mm_mul_ps(zf, _mm_sub_ps(_mm_mul_ps(zf, six), fifteen)), ten));
+                
+                alignas(16) int Z[4];
+                _mm_store_si128((__m128i*)Z, _mm_and_si128(zi, mask255));
+                __m128i h00 = _mm_setr_epi32(perm[rowA + Z[0]], perm[rowA + Z[1]], perm[rowA + Z[2]], perm[rowA + Z[3]]);
+                __m128i h10 = _mm_setr_epi32(perm[rowB + Z[0]], perm[rowB + Z[1]], perm[rowB + Z[2]], perm[rowB + Z[3]]);
+                __m128i h01 = _mm_setr_epi32(perm[rowA + Z[0] + 1], perm[rowA + Z[1] + 1], perm[rowA + Z[2] + 1], perm[rowA + Z[3] + 1]);
+                __m128i h11 = _mm_setr_epi32(perm[rowB + Z[0] + 1], perm[rowB + Z[1] + 1], perm[rowB + Z[2] + 1], perm[rowB + Z[3] + 1]);
+                
+                // grad(): hash bits 0 and 1 become the sign bits of the x and z terms
+                auto gradV = [](__m128i h, __m128 gx, __m128 gz) {
+                    __m128 signX = _mm_castsi128_ps(_mm_slli_epi32(h, 31));
+                    __m128 signZ = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(h, 1), 31));
+                    return _mm_add_ps(_mm_xor_ps(gx, signX), _mm_xor_ps(gz, signZ));
+                };
+                
+                __m128 g00 = gradV(h00, xfV, zf);
+                __m128 g10 = gradV(h10, xf1V, zf);
+                __m128 g01 = gradV(h01, xfV, zf1);
+                __m128 g11 = gradV(h11, xf1V, zf1);
+                
+                __m128 x0 = _mm_add_ps(g00, _mm_mul_ps(uV, _mm_sub_ps(g10, g00)));
+                __m128 x1 = _mm_add_ps(g01, _mm_mul_ps(uV, _mm_sub_ps(g11, g01)));
+                __m128 n = _mm_add_ps(x0, _mm_mul_ps(v, _mm_sub_ps(x1, x0)));
+                
+                total[lane] = _mm_add_ps(total[lane], _mm_mul_ps(amplitudeV, n));
+            }
+            
+            amplitude *= gain;
+            frequency *= lacunarity;
+        }
+        
+        for (int lane = 0; lane < GRID_SIZE / 4; lane++) {
+            _mm_storeu_ps(out + i * GRID_SIZE + lane * 4, _mm_div_ps(total[lane], amplitudeSumV));
+        }
+    }
+#else
+    for (int i = 0; i < GRID_SIZE; i++) {
+        for (int j = 0; j < GRID_SIZE; j++) {
+            out[i * GRID_SIZE + j] = fractal(xs[i], zs[j], octaves, lacunarity, gain);
+        }
+    }
+#endif
+}
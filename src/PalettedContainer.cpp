@@ -0,0 +1,132 @@
+#include "PalettedContainer.h"
+
+PalettedContainer::PalettedContainer(BlockType fill)
+    : palette(1, fill), paletteCounts(1, SECTION_VOLUME),
+      bitsPerEntry(0), liveEntries(1) {
+}
+
+int PalettedContainer::bitsForEntries(int entries) {
+    int bits = MIN_BITS;
+    while ((1 << bits) < entries) {
+        bits++;
+    }
+    return bits;
+}
+
+void PalettedContainer::writeIndex(int cell, uint32_t value) {
+    if (bitsPerEntry == 0) return;
+    
+    const uint64_t mask = (1ull << bitsPerEntry) - 1;
+    int bit = cell * bitsPerEntry;
+    int word = bit >> 6;
+    int offset = bit & 63;
+    
+    data[word] = (data[word] & ~(mask << offset)) | ((uint64_t)value << offset);
+    if (offset + bitsPerEntry > 64) {
+        int spill = 64 - offset;
+        data[word + 1] = (data[word + 1] & ~(mask >> spill)) | ((uint64_t)value >> spill);
+    }
+}
+
+int PalettedContainer::findOrAddPaletteEntry(BlockType type) {
+    int freeSlot = -1;
+    for (int i = 0; i < (int)palette.size(); i++) {
+        if (paletteCounts[i] == 0) {
+            if (freeSlot < 0) freeSlot = i;
+        } else if (palette[i] == type) {
+            return i;
+        }
+    }
+    
+    // Reuse a slot freed by an earlier removal before growing the palette
+    if (freeSlot >= 0) {
+        palette[freeSlot] = type;
+        liveEntries++;
+        return freeSlot;
+    }
+    
+    if ((int)palette.size() >= (1 << bitsPerEntry)) {
+        resize(bitsPerEntry + 1);
+    }
+    palette.push_back(type);
+    paletteCounts.push_back(0);
+    liveEntries++;
+    return (int)palette.size() - 1;
+}
+
+void PalettedContainer::set(int cell, BlockType type) {
+    uint32_t oldIndex = readIndex(cell);
+    if (palette[oldIndex] == type) return;
+    
+    int newIndex = findOrAddPaletteEntry(type);
+    // Growing the palette may have repacked, so re-read the old entry
+    oldIndex = readIndex(cell);
+    writeIndex(cell, newIndex);
+    paletteCounts[newIndex]++;
+    
+    if (--paletteCounts[oldIndex] == 0) {
+        liveEntries--;
+        // Shrink with one bit of hysteresis so alternating edits don't repack every time
+        if (bitsForEntries(liveEntries) < bitsPerEntry - 1) {
+            compact();
+        }
+    }
+}
+
+void PalettedContainer::resize(int newBits) {
+    std::vector<uint32_t> indices(SECTION_VOLUME);
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        indices[i] = readIndex(i);
+    }
+    
+    bitsPerEntry = newBits;
+    data.assign((SECTION_VOLUME * newBits + 63) / 64, 0);
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        writeIndex(i, indices[i]);
+    }
+}
+
+void PalettedContainer::compact() {
+    // Map old palette slots onto a dense palette of live entries
+    std::vector<uint32_t> remap(palette.size(), 0);
+    std::vector<BlockType> newPalette;
+    std::vector<uint16_t> newCounts;
+    for (int i = 0; i < (int)palette.size(); i++) {
+        if (paletteCounts[i] > 0) {
+            remap[i] = (uint32_t)newPalette.size();
+            newPalette.push_back(palette[i]);
+            newCounts.push_back(paletteCounts[i]);
+        }
+    }
+    
+    int newBits = bitsForEntries((int)newPalette.size());
+    if (newPalette.size() == palette.size() && newBits == bitsPerEntry) return;
+    
+    std::vector<uint32_t> indices(SECTION_VOLUME);
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        indices[i] = remap[readIndex(i)];
+    }
+    
+    palette.swap(newPalette);
+    paletteCounts.swap(newCounts);
+    liveEntries = (int)palette.size();
+    bitsPerEntry = newBits;
+    data.assign((SECTION_VOLUME * newBits + 63) / 64, 0);
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        writeIndex(i, indices[i]);
+    }
+}
+
+BlockType PalettedContainer::getUniformType() const {
+    for (int i = 0; i < (int)palette.size(); i++) {
+        if (paletteCounts[i] > 0) return palette[i];
+    }
+    return BlockType::AIR;
+}
+
+size_t PalettedContainer::memoryUsage() const {
+    return sizeof(*this) +
+           palette.capacity() * sizeof(BlockType) +
+           paletteCounts.capacity() * sizeof(uint16_t) +
+           data.capacity() * sizeof(uint64_t);
+}
@@ -1,20 +1,58 @@
 #include "Renderer.h"
+#include "Collision.h"
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+namespace {
+
+// Default distance rings: chunks beyond DEFAULT_LOD_DISTANCES[n] use level n + 1
+const float DEFAULT_LOD_DISTANCES[ChunkMesher::MAX_LOD] = { 96.0f, 160.0f, 224.0f };
+// A chunk keeps its current level until it is this far past a ring, so walking
+// along a boundary doesn't keep rebuilding it
+const float LOD_HYSTERESIS = 8.0f;
+
+// Horizontal distance from the camera to a chunk's centre column
+float chunkDistance(const Vector3& camera, int chunkX, int chunkZ) {
+    float chunkCenterX = chunkX * CHUNK_WIDTH + CHUNK_WIDTH / 2;
+    float chunkCenterZ = chunkZ * CHUNK_DEPTH + CHUNK_DEPTH / 2;
+    return sqrt((camera.x - chunkCenterX) * (camera.x - chunkCenterX) +
+                (camera.z - chunkCenterZ) * (camera.z - chunkCenterZ));
+}
+
+// The player's collision box; the camera sits at its eyes
+const float PLAYER_EYE_HEIGHT = 1.8f;
+const float PLAYER_HALF_WIDTH = 0.3f;
+const float PLAYER_HEAD_CLEARANCE = 0.1f; // Top of the head above the eyes
+
+AABB playerBox(const Vector3& eye) {
+    return AABB::standingAt(eye - Vector3(0.0f, PLAYER_EYE_HEIGHT, 0.0f), PLAYER_HALF_WIDTH,
+                            PLAYER_EYE_HEIGHT + PLAYER_HEAD_CLEARANCE);
+}
+
+} // namespace
 
 Renderer::Renderer(World* w) : world(w), mode(RenderMode::SOLID),
-    cameraPosition(64.0f, 50.0f, 64.0f), velocity(0.0f, 0.0f, 0.0f), 
+    cameraPosition(64.0f, 50.0f, 64.0f), previousPosition(cameraPosition), interpolation(1.0f),
+    eyePosition(cameraPosition), velocity(0.0f, 0.0f, 0.0f), 
     cameraYaw(-45.0f), cameraPitch(-20.0f), isOnGround(false), isJumping(false),
     isInWater(false), isSwimming(false), fieldOfView(45.0f),
     showMenu(false), selectedMenuItem(0), showPlayerModel(true), showDebugInfo(false), flightMode(false),
     mouseSensitivity(0.1f), movementSpeed(8.0f), showInventory(false),
     isSwinging(false), swingProgress(0.0f), swingTimer(0.0f), currentElbowAngle(0.0f),
-    textureAtlas(0), texturesLoaded(false) {
+    textureAtlas(0), texturesLoaded(false), framesPerSecond(0.0f) {
+    for (int lod = 0; lod < ChunkMesher::MAX_LOD; lod++) {
+        lodDistances[lod] = DEFAULT_LOD_DISTANCES[lod];
+    }
 }
 
 Renderer::~Renderer() {
+    // Stop the workers before the meshes they would report on go away
+    meshWorkers.reset();
 }
 
-void Renderer::init() {
+bool Renderer::init() {
     // Initialize OpenGL settings
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
@@ -26,27 +64,35 @@ void Renderer::init() {
     
     // Load textures
     loadTextures();
+    // Chunk meshes hold packed vertices that only the shader can unpack, so
+    // without it there is no world to draw
+    if (!chunkShader.init(ChunkMesher::ATLAS_TILES_PER_ROW)) {
+        std::cout << "Error: chunk shader unavailable, OpenGL 2.0 with GLSL 1.20 is required" << std::endl;
+        return false;
+    }
+    for (ChunkDrawList& drawList : chunkDrawLists) {
+        drawList.init();
+    }
+    
+    // Chunk meshes are built off the GLUT thread
+    meshWorkers.reset(new MeshWorkerPool());
+    std::cout << "Mesh workers: " << meshWorkers->getThreadCount() << " threads" << std::endl;
     
     // Disable lighting for now to see pure colors
     glDisable(GL_LIGHTING);
     
     // Setup initial camera
     setupCamera();
+    return true;
 }
 
 void Renderer::initPlayerPosition() {
-    // Find a good starting position on solid ground
-    int startX = 64;  // Center of larger world
-    int startZ = 64;  // Center of larger world
-    
-    // Find ground level more thoroughly
-    int groundY = 0;
-    for (int y = WORLD_HEIGHT * CHUNK_HEIGHT - 1; y >= 0; y--) {
-        if (isBlockAt(startX, y, startZ)) {
-            groundY = y;
-            break;
-        }
-    }
+    // Find a good starting position on solid ground, in the column the world was generated around
+    int startX = (int)floor(world->getPlayerPosition().x);
+    int startZ = (int)floor(world->getPlayerPosition().z);
+    
+    // Find ground level (empty sections above the terrain are skipped)
+    int groundY = std::max(0, world->getSurfaceHeight(startX, startZ));
     
     cameraPosition.x = startX + 0.5f; // Center of block
     cameraPosition.y = groundY + 2.5f; // At least 2 blocks above ground (2.0 + 0.5 for player height)
@@ -62,7 +108,7 @@ void Renderer::initPlayerPosition() {
         bool clear2 = !isBlockAt(startX, testY + 1, startZ);
         
         if (clear1 && clear2) {
-            cameraPosition.y = testY + 0.5f; // Player eye level
+            cameraPosition.y = testY + PLAYER_EYE_HEIGHT; // Feet on the block below
             foundClearSpace = true;
             std::cout << "Found clear spawn space at Y=" << testY << std::endl;
             break;
@@ -75,6 +121,7 @@ void Renderer::initPlayerPosition() {
         std::cout << "No clear space found, spawning high at Y=" << (groundY + 10.0f) << std::endl;
     }
     
+    previousPosition = cameraPosition; // Don't interpolate from the old spot
     velocity = Vector3(0, 0, 0);
     isOnGround = false; // Let physics determine ground state
     isJumping = false;
@@ -87,7 +134,10 @@ void Renderer::initPlayerPosition() {
 void Renderer::render() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
+    // Everything drawn this frame, culling and LOD included, works from one eye
+    eyePosition = getRenderPosition();
     setupCamera();
+    uploadFinishedMeshes();
     renderWorld();
     
     // Only render player model if enabled and menu is not open
@@ -105,6 +155,10 @@ void Renderer::render() {
         renderHotbar();
     }
     
+    if (showDebugInfo && !showMenu) {
+        renderDebugInfo();
+    }
+    
     // Render menu on top if open
     if (showMenu) {
         renderMenu();
@@ -118,11 +172,12 @@ void Renderer::update(float deltaTime) {
     const float waterGravity = -5.0f;  // Much weaker gravity in water
     const float terminalVelocity = -50.0f;
     const float waterTerminalVelocity = -8.0f;  // Slower fall in water
-    const float playerHeight = 1.8f;
     const float waterResistance = 0.7f;  // More friction in water
     const float airFriction = 0.85f;
     const float flightFriction = 0.9f;   // Less friction in flight mode
     
+    previousPosition = cameraPosition;
+    
     // In flight mode, skip physics and collision detection
     if (flightMode) {
         // Simple movement with friction in flight mode
@@ -135,11 +190,7 @@ void Renderer::update(float deltaTime) {
         cameraPosition.y += velocity.y * deltaTime;
         cameraPosition.z += velocity.z * deltaTime;
         
-        // Keep player within world bounds
-        if (cameraPosition.x < 0) cameraPosition.x = 0;
-        if (cameraPosition.z < 0) cameraPosition.z = 0;
-        if (cameraPosition.x >= WORLD_WIDTH * CHUNK_WIDTH) cameraPosition.x = WORLD_WIDTH * CHUNK_WIDTH - 1;
-        if (cameraPosition.z >= WORLD_DEPTH * CHUNK_DEPTH) cameraPosition.z = WORLD_DEPTH * CHUNK_DEPTH - 1;
+        // The world is unbounded horizontally; only keep the player within its height
         if (cameraPosition.y < 0) cameraPosition.y = 0;
         if (cameraPosition.y >= WORLD_HEIGHT * CHUNK_HEIGHT) cameraPosition.y = WORLD_HEIGHT * CHUNK_HEIGHT - 1;
         
@@ -173,7 +224,6 @@ void Renderer::update(float deltaTime) {
     int posZ = (int)floor(cameraPosition.z);
     int headY = (int)floor(cameraPosition.y);
     int bodyY = (int)floor(cameraPosition.y - 0.5f);
-    int feetY = (int)floor(cameraPosition.y - playerHeight);
     
     // Player is in water if head or body is in water
     isInWater = isWaterAt(posX, headY, posZ) || isWaterAt(posX, bodyY, posZ);
@@ -188,86 +238,31 @@ void Renderer::update(float deltaTime) {
         isOnGround = false;  // Can't be "on ground" while swimming
     } else {
         isSwimming = false;
-        if (!isOnGround) {
-            velocity.y += airGravity * deltaTime;
-            if (velocity.y < terminalVelocity) {
-                velocity.y = terminalVelocity;
-            }
+        // Applied on the ground too: the sweep below stops it, and finds the
+        // edge when there's nothing underneath any more
+        velocity.y += airGravity * deltaTime;
+        if (velocity.y < terminalVelocity) {
+            velocity.y = terminalVelocity;
         }
     }
     
-    // Apply X movement with collision (only check solid blocks, not water)
-    Vector3 newPos = cameraPosition;
-    newPos.x += velocity.x * deltaTime;
-    if (!isBlockAt((int)floor(newPos.x), (int)floor(newPos.y - playerHeight), (int)floor(newPos.z))) {
-        cameraPosition.x = newPos.x;
-    } else {
-        velocity.x = 0; // Stop horizontal movement if hitting solid wall
-    }
-    
-    // Apply Z movement with collision (only check solid blocks, not water)
-    newPos = cameraPosition;
-    newPos.z += velocity.z * deltaTime;
-    if (!isBlockAt((int)floor(newPos.x), (int)floor(newPos.y - playerHeight), (int)floor(newPos.z))) {
-        cameraPosition.z = newPos.z;
-    } else {
-        velocity.z = 0; // Stop horizontal movement if hitting solid wall
-    }
-    
-    // Apply Y movement with collision
-    newPos = cameraPosition;
-    newPos.y += velocity.y * deltaTime;
-    
-    // Update positions for collision check
-    posX = (int)floor(newPos.x);
-    posZ = (int)floor(newPos.z);
-    feetY = (int)floor(newPos.y - playerHeight);
-    headY = (int)floor(newPos.y);
-    
-    if (!isInWater) {
-        // Normal air physics
-        if (velocity.y < 0) { // Falling down
-            if (isBlockAt(posX, feetY, posZ)) {
-                // Hit ground - place player on top of block
-                cameraPosition.y = feetY + 1.0f + playerHeight;
-                velocity.y = 0;
-                isOnGround = true;
-                isJumping = false;
-            } else {
-                cameraPosition.y = newPos.y;
-                isOnGround = false;
-            }
-        } else if (velocity.y > 0) { // Moving up
-            if (isBlockAt(posX, headY, posZ)) {
-                // Hit ceiling
-                velocity.y = 0;
-                cameraPosition.y = headY - 0.1f; // Just below the block
-            } else {
-                cameraPosition.y = newPos.y;
-                isOnGround = false;
-            }
-        } else {
-            // Check if still on ground
-            if (isBlockAt(posX, feetY, posZ)) {
-                isOnGround = true;
-            } else {
-                isOnGround = false;
-            }
+    // Sweep the player's whole box through the blocks (water doesn't block)
+    VoxelCollider collider(*world);
+    AABB box = playerBox(cameraPosition);
+    CollisionResult collision = collider.move(box, velocity * deltaTime);
+    cameraPosition = cameraPosition + collision.motion;
+    
+    if (collision.hit[0]) velocity.x = 0; // Stop horizontal movement if hitting solid wall
+    if (collision.hit[2]) velocity.z = 0;
+    if (collision.hit[1]) {
+        if (velocity.y < 0 && !isInWater) {
+            // Landed
+            isOnGround = true;
+            isJumping = false;
         }
+        velocity.y = 0;
     } else {
-        // Swimming physics - can move freely in water
-        // Only check for solid blocks, not water
-        if (velocity.y < 0 && isBlockAt(posX, feetY, posZ)) {
-            // Hit solid ground while swimming
-            cameraPosition.y = feetY + 1.0f + playerHeight;
-            velocity.y = 0;
-        } else if (velocity.y > 0 && isBlockAt(posX, headY, posZ)) {
-            // Hit solid ceiling while swimming
-            velocity.y = 0;
-            cameraPosition.y = headY - 0.1f;
-        } else {
-            cameraPosition.y = newPos.y;
-        }
+        isOnGround = false;
     }
     
     // Apply appropriate friction
@@ -296,253 +291,247 @@ void Renderer::renderWorld() {
     if (!world) return;
     
     static bool firstRender = true;
-    int chunksRendered = 0;
-    const float RENDER_DISTANCE = 80.0f; // Only render chunks within this distance
-    
-    // Get camera chunk position
-    int camChunkX = (int)(cameraPosition.x / CHUNK_WIDTH);
-    int camChunkZ = (int)(cameraPosition.z / CHUNK_DEPTH);
-    
-    // Render chunks within render distance
-    for (int x = 0; x < WORLD_WIDTH; x++) {
-        for (int y = 0; y < WORLD_HEIGHT; y++) {
-            for (int z = 0; z < WORLD_DEPTH; z++) {
-                // Distance-based culling
-                float chunkCenterX = x * CHUNK_WIDTH + CHUNK_WIDTH / 2;
-                float chunkCenterZ = z * CHUNK_DEPTH + CHUNK_DEPTH / 2;
-                
-                float distanceToChunk = sqrt((cameraPosition.x - chunkCenterX) * (cameraPosition.x - chunkCenterX) +
-                                           (cameraPosition.z - chunkCenterZ) * (cameraPosition.z - chunkCenterZ));
-                
-                if (distanceToChunk <= RENDER_DISTANCE) {
-                    Chunk* chunk = world->getChunkAt(x, y, z);
-                    if (chunk) {
-                        renderChunk(chunk);
-                        chunksRendered++;
-                    }
+    
+    // Cull against the same matrices setupCamera just built
+    GLfloat projection[16], modelview[16];
+    glGetFloatv(GL_PROJECTION_MATRIX, projection);
+    glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+    frustum.extract(projection, modelview);
+    renderStats = RenderStats();
+    
+    // Chunks the camera can see into through open space
+    bool occlusionCulling = findReachableChunks();
+    
+    // Render state shared by every chunk draw. Packed vertices are only readable
+    // by the chunk shader, which also supplies the solid and wireframe colours.
+    bool useTextures = (mode == RenderMode::TEXTURED && texturesLoaded);
+    ChunkShading shading = useTextures ? ChunkShading::TEXTURED :
+                           (mode == RenderMode::WIREFRAME ? ChunkShading::WHITE : ChunkShading::BLOCK_COLOR);
+    glPolygonMode(GL_FRONT_AND_BACK, mode == RenderMode::WIREFRAME ? GL_LINE : GL_FILL);
+    if (useTextures) {
+        glEnable(GL_TEXTURE_2D);
+    } else {
+        glDisable(GL_TEXTURE_2D);
+    }
+    chunkShader.bind(textureAtlas, shading);
+    glEnableVertexAttribArray(ChunkShader::POSITION_ATTRIBUTE);
+    glEnableVertexAttribArray(ChunkShader::INFO_ATTRIBUTE);
+    for (ChunkDrawList& drawList : chunkDrawLists) {
+        drawList.clear();
+    }
+    translucentDraws.clear();
+    
+    // Render loaded chunks within render distance
+    int cameraChunkX = blockToChunkX((int)floor(eyePosition.x));
+    int cameraChunkZ = blockToChunkZ((int)floor(eyePosition.z));
+    float renderDistance = getRenderDistance();
+    int chunkRadius = (int)ceil(renderDistance / CHUNK_WIDTH) + 1;
+    for (int x = cameraChunkX - chunkRadius; x <= cameraChunkX + chunkRadius; x++) {
+        for (int z = cameraChunkZ - chunkRadius; z <= cameraChunkZ + chunkRadius; z++) {
+            // Distance-based culling
+            float distance = chunkDistance(eyePosition, x, z);
+            if (distance > renderDistance) continue;
+            
+            for (int y = 0; y < WORLD_HEIGHT; y++) {
+                Chunk* chunk = world->getChunkAt(x, y, z);
+                if (chunk) {
+                    bool reachable = !occlusionCulling || reachableChunks.count(chunk->getCoord()) > 0;
+                    renderChunk(chunk, reachable, distance);
                 }
             }
         }
     }
     
-    if (firstRender) {
-        std::cout << "First render: " << chunksRendered << " chunks rendered" << std::endl;
-        firstRender = false;
+    // Blending needs what is behind each translucent surface drawn first, both the
+    // opaque world and farther water, so those chunks go last and far to near
+    std::sort(translucentDraws.begin(), translucentDraws.end(),
+              [](const TranslucentDraw& a, const TranslucentDraw& b) {
+                  return a.distanceSquared > b.distanceSquared;
+              });
+    ChunkDrawList& translucentList = chunkDrawLists[(int)RenderLayer::TRANSLUCENT];
+    for (const TranslucentDraw& draw : translucentDraws) {
+        translucentList.add(draw.first, draw.count, draw.origin);
     }
-}
-
-void Renderer::renderChunk(Chunk* chunk) {
-    if (!chunk) return;
-    
-    // Get chunk world position
-    Vector3 chunkPos = chunk->getPosition();
-    
-    // Convert chunk coordinates to world coordinates
-    int worldX = chunkPos.x * CHUNK_WIDTH;
-    int worldY = chunkPos.y * CHUNK_HEIGHT;
-    int worldZ = chunkPos.z * CHUNK_DEPTH;
-    
-    static bool firstChunkRender = true;
-    int blocksRendered = 0;
-    
-    // Render blocks in chunk
-    for (int x = 0; x < CHUNK_WIDTH; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int z = 0; z < CHUNK_DEPTH; z++) {
-                Block& block = chunk->getBlock(x, y, z);
-                if (!block.isEmpty()) {
-                    renderBlock(block, worldX + x, worldY + y, worldZ + z);
-                    blocksRendered++;
-                }
-            }
+    renderStats.translucentChunks = (int)translucentDraws.size();
+    
+    // Everything that survived culling goes to GL in one batch per pass;
+    // translucent surfaces blend over the result without hiding each other.
+    for (int layer = 0; layer < RENDER_LAYER_COUNT; layer++) {
+        ChunkDrawList& drawList = chunkDrawLists[layer];
+        if (drawList.isEmpty()) continue;
+        
+        bool translucent = (layer == (int)RenderLayer::TRANSLUCENT);
+        if (translucent) {
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDepthMask(GL_FALSE);
+        }
+        chunkShader.setLayer((RenderLayer)layer);
+        drawList.submit(geometryArena);
+        renderStats.drawCalls += drawList.getLastDrawCalls();
+        if (translucent) {
+            glDepthMask(GL_TRUE);
+            glDisable(GL_BLEND);
         }
     }
     
-    if (firstChunkRender) {
-        std::cout << "First chunk render: " << blocksRendered << " blocks rendered at chunk pos (" 
-                  << chunkPos.x << "," << chunkPos.y << "," << chunkPos.z << ")" << std::endl;
-        std::cout << "World offset: (" << worldX << "," << worldY << "," << worldZ << ")" << std::endl;
-        firstChunkRender = false;
+    chunkShader.unbind();
+    glDisableVertexAttribArray(ChunkShader::POSITION_ATTRIBUTE);
+    glDisableVertexAttribArray(ChunkShader::INFO_ATTRIBUTE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glDisable(GL_TEXTURE_2D);
+    
+    if (firstRender) {
+        std::cout << "First render: " << renderStats.chunksDrawn << " chunks rendered" << std::endl;
+        firstRender = false;
     }
 }
 
-void Renderer::renderBlock(Block& block, int x, int y, int z) {
-    // Simple cube rendering
-    glPushMatrix();
-    glTranslatef(x, y, z);
-    
-    // Handle wireframe mode
-    if (mode == RenderMode::WIREFRAME) {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glColor3f(1.0f, 1.0f, 1.0f); // White wireframe
-    } else {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+bool Renderer::findReachableChunks() {
+    reachableChunks.clear();
+    
+    ChunkCoord start = { blockToChunkX((int)floor(eyePosition.x)),
+                         blockToChunkY((int)floor(eyePosition.y)),
+                         blockToChunkZ((int)floor(eyePosition.z)) };
+    if (!world->getChunkAt(start.x, start.y, start.z)) {
+        return false; // Camera outside the world: nothing to flood from
     }
     
-    bool useTextures = (mode == RenderMode::TEXTURED && texturesLoaded);
+    // Breadth-first flood from the camera's chunk. A chunk is only left through
+    // a face its interior connects to the face it was entered by, and the flood
+    // never steps back toward the camera, so sealed-off caves and chunks behind
+    // terrain are never reached.
+    struct Step {
+        ChunkCoord coord;
+        int entryFace;  // Face of this chunk the flood came in through (-1 at the start)
+        int directions; // Bit per direction travelled so far
+    };
+    std::deque<Step> queue;
+    queue.push_back({ start, -1, 0 });
+    reachableChunks.insert(start);
     
-    if (useTextures) {
-        glBindTexture(GL_TEXTURE_2D, textureAtlas);
-        glColor3f(1.0f, 1.0f, 1.0f); // White to show texture colors
-        
-        float texCoords[8];
-        getBlockTexCoords(block.type, texCoords);
-        
-        // Render cube with textures (face culling)
-        glBegin(GL_QUADS);
-        
-        // Front face (z = 0)
-        if (shouldRenderFace(x, y, z, 0)) {
-            glNormal3f(0.0f, 0.0f, -1.0f);
-            glTexCoord2f(texCoords[0], texCoords[1]); glVertex3f(0, 0, 0);
-            glTexCoord2f(texCoords[2], texCoords[3]); glVertex3f(1, 0, 0);
-            glTexCoord2f(texCoords[4], texCoords[5]); glVertex3f(1, 1, 0);
-            glTexCoord2f(texCoords[6], texCoords[7]); glVertex3f(0, 1, 0);
-        }
-        
-        // Back face (z = 1)
-        if (shouldRenderFace(x, y, z, 1)) {
-            glNormal3f(0.0f, 0.0f, 1.0f);
-            glTexCoord2f(texCoords[2], texCoords[3]); glVertex3f(1, 0, 1);
-            glTexCoord2f(texCoords[0], texCoords[1]); glVertex3f(0, 0, 1);
-            glTexCoord2f(texCoords[6], texCoords[7]); glVertex3f(0, 1, 1);
-            glTexCoord2f(texCoords[4], texCoords[5]); glVertex3f(1, 1, 1);
-        }
+    while (!queue.empty()) {
+        Step step = queue.front();
+        queue.pop_front();
         
-        // Top face (y = 1)
-        if (shouldRenderFace(x, y, z, 2)) {
-            glNormal3f(0.0f, 1.0f, 0.0f);
-            glTexCoord2f(texCoords[0], texCoords[1]); glVertex3f(0, 1, 0);
-            glTexCoord2f(texCoords[2], texCoords[3]); glVertex3f(1, 1, 0);
-            glTexCoord2f(texCoords[4], texCoords[5]); glVertex3f(1, 1, 1);
-            glTexCoord2f(texCoords[6], texCoords[7]); glVertex3f(0, 1, 1);
-        }
-        
-        // Bottom face (y = 0)
-        if (shouldRenderFace(x, y, z, 3)) {
-            glNormal3f(0.0f, -1.0f, 0.0f);
-            glTexCoord2f(texCoords[6], texCoords[7]); glVertex3f(0, 0, 1);
-            glTexCoord2f(texCoords[4], texCoords[5]); glVertex3f(1, 0, 1);
-            glTexCoord2f(texCoords[2], texCoords[3]); glVertex3f(1, 0, 0);
-            glTexCoord2f(texCoords[0], texCoords[1]); glVertex3f(0, 0, 0);
-        }
-        
-        // Right face (x = 1)
-        if (shouldRenderFace(x, y, z, 4)) {
-            glNormal3f(1.0f, 0.0f, 0.0f);
-            glTexCoord2f(texCoords[0], texCoords[1]); glVertex3f(1, 0, 0);
-            glTexCoord2f(texCoords[2], texCoords[3]); glVertex3f(1, 0, 1);
-            glTexCoord2f(texCoords[4], texCoords[5]); glVertex3f(1, 1, 1);
-            glTexCoord2f(texCoords[6], texCoords[7]); glVertex3f(1, 1, 0);
-        }
+        auto meshIt = chunkMeshes.find(step.coord);
+        const ChunkMesh* mesh = (meshIt != chunkMeshes.end()) ? &meshIt->second.mesh : nullptr;
         
-        // Left face (x = 0)
-        if (shouldRenderFace(x, y, z, 5)) {
-            glNormal3f(-1.0f, 0.0f, 0.0f);
-            glTexCoord2f(texCoords[2], texCoords[3]); glVertex3f(0, 0, 1);
-            glTexCoord2f(texCoords[0], texCoords[1]); glVertex3f(0, 0, 0);
-            glTexCoord2f(texCoords[6], texCoords[7]); glVertex3f(0, 1, 0);
-            glTexCoord2f(texCoords[4], texCoords[5]); glVertex3f(0, 1, 1);
-        }
-        
-    } else {
-        // Set color based on block type (fallback for solid mode)
-        switch (block.type) {
-            case BlockType::GRASS:
-                glColor3f(0.2f, 0.8f, 0.2f);  // Bright Green
-                break;
-            case BlockType::DIRT:
-                glColor3f(0.6f, 0.4f, 0.2f);  // Brown
-                break;
-            case BlockType::STONE:
-                glColor3f(0.6f, 0.6f, 0.6f);  // Gray
-                break;
-            case BlockType::WOOD:
-                glColor3f(0.6f, 0.3f, 0.1f);  // Dark Brown
-                break;
-            case BlockType::LEAVES:
-                glColor3f(0.1f, 0.6f, 0.1f);  // Dark Green
-                break;
-            case BlockType::WATER:
-                glColor3f(0.2f, 0.4f, 0.8f);  // Blue
-                break;
-            case BlockType::SAND:
-                glColor3f(0.9f, 0.8f, 0.6f);  // Sandy Yellow
-                break;
-            case BlockType::COAL_ORE:
-                glColor3f(0.3f, 0.3f, 0.3f);  // Dark Gray with black spots
-                break;
-            case BlockType::IRON_ORE:
-                glColor3f(0.8f, 0.7f, 0.6f);  // Beige with brown spots
-                break;
-            case BlockType::DIAMOND_ORE:
-                glColor3f(0.7f, 0.9f, 0.9f);  // Light Blue
-                break;
-            default:
-                glColor3f(0.8f, 0.8f, 0.8f);  // Light Gray
-        }
-        
-        // Render cube with normals and face culling
-        glBegin(GL_QUADS);
-        
-        // Front face (z = 0)
-        if (shouldRenderFace(x, y, z, 0)) {
-            glNormal3f(0.0f, 0.0f, -1.0f);
-            glVertex3f(0, 0, 0);
-            glVertex3f(1, 0, 0);
-            glVertex3f(1, 1, 0);
-            glVertex3f(0, 1, 0);
-        }
-        
-        // Back face (z = 1)
-        if (shouldRenderFace(x, y, z, 1)) {
-            glNormal3f(0.0f, 0.0f, 1.0f);
-            glVertex3f(1, 0, 1);
-            glVertex3f(0, 0, 1);
-            glVertex3f(0, 1, 1);
-            glVertex3f(1, 1, 1);
-        }
-        
-        // Top face (y = 1)
-        if (shouldRenderFace(x, y, z, 2)) {
-            glNormal3f(0.0f, 1.0f, 0.0f);
-            glVertex3f(0, 1, 0);
-            glVertex3f(1, 1, 0);
-            glVertex3f(1, 1, 1);
-            glVertex3f(0, 1, 1);
+        for (int dir = 0; dir < FACE_COUNT; dir++) {
+            if (step.directions & (1 << oppositeFace(dir))) continue;
+            if (step.entryFace >= 0 && mesh && !mesh->facesConnected(step.entryFace, dir)) continue;
+            
+            ChunkCoord next = { step.coord.x + FACE_DIRECTIONS[dir][0],
+                                step.coord.y + FACE_DIRECTIONS[dir][1],
+                                step.coord.z + FACE_DIRECTIONS[dir][2] };
+            if (reachableChunks.count(next)) continue;
+            if (!world->getChunkAt(next.x, next.y, next.z)) continue;
+            if (chunkDistance(eyePosition, next.x, next.z) > getRenderDistance()) continue;
+            
+            Vector3 origin(next.x * CHUNK_WIDTH, next.y * CHUNK_HEIGHT, next.z * CHUNK_DEPTH);
+            if (!frustum.intersectsBox(origin, origin + Vector3(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_DEPTH))) continue;
+            
+            reachableChunks.insert(next);
+            queue.push_back({ next, oppositeFace(dir), step.directions | (1 << dir) });
         }
-        
-        // Bottom face (y = 0)
-        if (shouldRenderFace(x, y, z, 3)) {
-            glNormal3f(0.0f, -1.0f, 0.0f);
-            glVertex3f(0, 0, 1);
-            glVertex3f(1, 0, 1);
-            glVertex3f(1, 0, 0);
-            glVertex3f(0, 0, 0);
+    }
+    return true;
+}
+
+int Renderer::chooseLod(float distance, int currentLod) const {
+    auto lodAt = [this](float d) {
+        int lod = 0;
+        while (lod < ChunkMesher::MAX_LOD && d > lodDistances[lod]) lod++;
+        return lod;
+    };
+    if (currentLod >= lodAt(distance - LOD_HYSTERESIS) && currentLod <= lodAt(distance + LOD_HYSTERESIS)) {
+        return currentLod;
+    }
+    return lodAt(distance);
+}
+
+bool Renderer::renderChunk(Chunk* chunk, bool reachable, float distance) {
+    if (!chunk) return false;
+    
+    // Queue a rebuild if the chunk (or a neighbour's border) changed or it crossed
+    // a detail ring; the old mesh keeps drawing until the new one is uploaded
+    ChunkRenderData& entry = chunkMeshes[chunk->getCoord()];
+    int lod = chooseLod(distance, entry.mesh.isBuilt() ? entry.mesh.getLod() : -1);
+    bool stale = !entry.mesh.isBuilt() || entry.mesh.getRevision() != chunk->getRevision() ||
+                 entry.mesh.getLod() != lod;
+    if (stale && !entry.buildPending && meshWorkers) {
+        meshWorkers->submit(ChunkSnapshot::capture(*chunk, lod));
+        entry.buildPending = true;
+    }
+    
+    if (entry.mesh.isEmpty()) return false;
+    
+    // Mesh vertices are chunk-relative
+    ChunkCoord coord = chunk->getCoord();
+    Vector3 origin(coord.x * CHUNK_WIDTH, coord.y * CHUNK_HEIGHT, coord.z * CHUNK_DEPTH);
+    if (!frustum.intersectsBox(origin + entry.mesh.getBoundsMin(), origin + entry.mesh.getBoundsMax())) {
+        renderStats.chunksFrustumCulled++;
+        return false;
+    }
+    if (!reachable) {
+        renderStats.chunksOcclusionCulled++;
+        return false;
+    }
+    
+    renderStats.chunksDrawn++;
+    renderStats.chunksPerLod[entry.mesh.getLod()]++;
+    renderStats.verticesDrawn += entry.mesh.getVertexCount();
+    GLsizei solidCount = entry.mesh.getLayerCount(RenderLayer::SOLID);
+    if (solidCount > 0) {
+        chunkDrawLists[(int)RenderLayer::SOLID].add(entry.mesh.getLayerFirst(RenderLayer::SOLID), solidCount, origin);
+    }
+    GLsizei translucentCount = entry.mesh.getLayerCount(RenderLayer::TRANSLUCENT);
+    if (translucentCount > 0) {
+        Vector3 offset = origin + Vector3(CHUNK_WIDTH * 0.5f, CHUNK_HEIGHT * 0.5f, CHUNK_DEPTH * 0.5f) - eyePosition;
+        float distanceSquared = offset.x * offset.x + offset.y * offset.y + offset.z * offset.z;
+        translucentDraws.push_back({ entry.mesh.getLayerFirst(RenderLayer::TRANSLUCENT), translucentCount, origin,
+                                     distanceSquared });
+    }
+    return true;
+}
+
+void Renderer::uploadFinishedMeshes() {
+    if (!meshWorkers) return;
+    
+    // Free the buffers of chunks the world has unloaded. Entries with a build in
+    // flight are kept until its result arrives so the pending flag stays accurate.
+    for (auto it = chunkMeshes.begin(); it != chunkMeshes.end();) {
+        const ChunkCoord& c = it->first;
+        if (!it->second.buildPending && !world->getChunkAt(c.x, c.y, c.z)) {
+            it = chunkMeshes.erase(it);
+        } else {
+            ++it;
         }
+    }
+    
+    // Bound the per-frame cost of GPU uploads; leftovers wait for the next frame
+    const int MAX_UPLOADS_PER_FRAME = 8;
+    const double UPLOAD_BUDGET_MS = 4.0;
+    
+    auto start = std::chrono::steady_clock::now();
+    MeshResult result;
+    for (int uploads = 0; uploads < MAX_UPLOADS_PER_FRAME; uploads++) {
+        if (!meshWorkers->pollResult(result)) break;
         
-        // Right face (x = 1)
-        if (shouldRenderFace(x, y, z, 4)) {
-            glNormal3f(1.0f, 0.0f, 0.0f);
-            glVertex3f(1, 0, 0);
-            glVertex3f(1, 0, 1);
-            glVertex3f(1, 1, 1);
-            glVertex3f(1, 1, 0);
+        ChunkRenderData& entry = chunkMeshes[result.coord];
+        entry.buildPending = false;
+        if (!world->getChunkAt(result.coord.x, result.coord.y, result.coord.z)) {
+            continue; // Unloaded while the mesh was being built
         }
+        entry.mesh.upload(result.mesh, result.revision, geometryArena);
         
-        // Left face (x = 0)
-        if (shouldRenderFace(x, y, z, 5)) {
-            glNormal3f(-1.0f, 0.0f, 0.0f);
-            glVertex3f(0, 0, 1);
-            glVertex3f(0, 0, 0);
-            glVertex3f(0, 1, 0);
-            glVertex3f(0, 1, 1);
-        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > UPLOAD_BUDGET_MS) break;
     }
     
-    glEnd();
-    
-    glPopMatrix();
+    // Ranges move here, before this frame's draw list reads their offsets
+    geometryArena.defragmentIfNeeded();
 }
 
 void Renderer::setupCamera() {
@@ -555,7 +544,8 @@ void Renderer::setupCamera() {
     glGetIntegerv(GL_VIEWPORT, viewport);
     double aspectRatio = (double)viewport[2] / viewport[3];
     
-    gluPerspective(fieldOfView, aspectRatio, 0.1, 200.0);
+    // Far enough to see the farthest rendered chunk's far corner
+    gluPerspective(fieldOfView, aspectRatio, 0.1, getRenderDistance() + CHUNK_WIDTH * 2);
     
     // Setup modelview matrix
     glMatrixMode(GL_MODELVIEW);
@@ -564,7 +554,7 @@ void Renderer::setupCamera() {
     // Apply camera transformations
     glRotatef(-cameraPitch, 1.0f, 0.0f, 0.0f);
     glRotatef(-cameraYaw, 0.0f, 1.0f, 0.0f);
-    glTranslatef(-cameraPosition.x, -cameraPosition.y, -cameraPosition.z);
+    glTranslatef(-eyePosition.x, -eyePosition.y, -eyePosition.z);
 }
 
 void Renderer::setupLighting() {
@@ -635,9 +625,10 @@ void Renderer::swimDown() {
         // Swimming downward in water
         velocity.y -= 5.0f; // Swimming velocity downward
         if (velocity.y < -8.0f) velocity.y = -8.0f; // Cap downward swimming speed
-    } else {
-        // Creative mode fly down (legacy)
-        cameraPosition.y -= 0.5f;
+    } else if (world) {
+        // Creative mode fly down (legacy), but not into the ground
+        AABB box = playerBox(cameraPosition);
+        cameraPosition.y += VoxelCollider(*world).sweepAxis(box, 1, -0.5f);
     }
 }
 
@@ -673,58 +664,28 @@ void Renderer::toggleFlightMode() {
 bool Renderer::isBlockAt(int x, int y, int z) {
     if (!world) return false;
     
-    // Bounds check - don't go outside world
-    if (x < 0 || z < 0 || y < 0) return false;
-    if (x >= WORLD_WIDTH * CHUNK_WIDTH || z >= WORLD_DEPTH * CHUNK_DEPTH || y >= WORLD_HEIGHT * CHUNK_HEIGHT) return false;
-    
-    Block* block = world->getBlockAt(x, y, z);
-    if (!block) return false;
-    
-    return (!block->isEmpty() && block->isSolid());
+    // Unloaded space, including above and below the world, reads as air
+    return world->isBlockSolidAt(x, y, z);
 }
 
 bool Renderer::isWaterAt(int x, int y, int z) {
     if (!world) return false;
     
-    // Bounds check - don't go outside world
-    if (x < 0 || z < 0 || y < 0) return false;
-    if (x >= WORLD_WIDTH * CHUNK_WIDTH || z >= WORLD_DEPTH * CHUNK_DEPTH || y >= WORLD_HEIGHT * CHUNK_HEIGHT) return false;
-    
-    Block* block = world->getBlockAt(x, y, z);
-    if (!block) return false;
-    
-    return (block->type == BlockType::WATER);
+    // Unloaded space, including above and below the world, reads as air
+    return (world->getBlockAt(x, y, z).type == BlockType::WATER);
 }
 
 int Renderer::findGroundLevel(int x, int z) {
     if (!world) return 10;
     
-    // Search from top to bottom for the first solid block
-    for (int y = WORLD_HEIGHT * CHUNK_HEIGHT - 1; y >= 0; y--) {
-        if (isBlockAt(x, y, z)) {
-            return y + 1; // Return the position above the solid block
-        }
+    // Highest solid block in the column, skipping empty sections
+    int surfaceY = world->getSurfaceHeight(x, z);
+    if (surfaceY >= 0) {
+        return surfaceY + 1; // Return the position above the solid block
     }
     return 10; // Default height if no ground found
 }
 
-bool Renderer::shouldRenderFace(int x, int y, int z, int faceDirection) {
-    // Face directions: 0=front, 1=back, 2=top, 3=bottom, 4=right, 5=left
-    int checkX = x, checkY = y, checkZ = z;
-    
-    switch (faceDirection) {
-        case 0: checkZ -= 1; break; // Front face - check block in front
-        case 1: checkZ += 1; break; // Back face - check block behind
-        case 2: checkY += 1; break; // Top face - check block above
-        case 3: checkY -= 1; break; // Bottom face - check block below
-        case 4: checkX += 1; break; // Right face - check block to right
-        case 5: checkX -= 1; break; // Left face - check block to left
-    }
-    
-    // Don't render face if there's a solid block adjacent to it
-    return !isBlockAt(checkX, checkY, checkZ);
-}
-
 void Renderer::rotateCamera(float yaw, float pitch) {
     cameraYaw += yaw;
     cameraPitch += pitch;
@@ -832,24 +793,14 @@ bool Renderer::loadTextures() {
 }
 
 void Renderer::getBlockTexCoords(BlockType blockType, float* texCoords) {
-    const float TEXTURE_SIZE = 64.0f;
-    const float ATLAS_SIZE = 512.0f;
-    const int TEXTURES_PER_ROW = 8;
-    
-    int blockIndex = (int)blockType;
-    int row = blockIndex / TEXTURES_PER_ROW;
-    int col = blockIndex % TEXTURES_PER_ROW;
-    
-    float u = col * TEXTURE_SIZE / ATLAS_SIZE;
-    float v = row * TEXTURE_SIZE / ATLAS_SIZE;
-    float du = TEXTURE_SIZE / ATLAS_SIZE;
-    float dv = TEXTURE_SIZE / ATLAS_SIZE;
+    float u, v, size;
+    ChunkMesher::getTileUV(blockType, u, v, size);
     
     // UV coordinates for a quad (bottom-left, bottom-right, top-right, top-left)
-    texCoords[0] = u;      texCoords[1] = v;       // Bottom-left
-    texCoords[2] = u + du; texCoords[3] = v;       // Bottom-right
-    texCoords[4] = u + du; texCoords[5] = v + dv;  // Top-right
-    texCoords[6] = u;      texCoords[7] = v + dv;  // Top-left
+    texCoords[0] = u;        texCoords[1] = v;         // Bottom-left
+    texCoords[2] = u + size; texCoords[3] = v;         // Bottom-right
+    texCoords[4] = u + size; texCoords[5] = v + size;  // Top-right
+    texCoords[6] = u;        texCoords[7] = v + size;  // Top-left
 }
 
 void Renderer::renderPlayerModel() {
@@ -1321,6 +1272,69 @@ void Renderer::renderMenu() {
     glMatrixMode(GL_MODELVIEW);
 }
 
+void Renderer::renderDebugInfo() {
+    // Frame rate averaged over half-second windows
+    static int frameCount = 0;
+    static int windowStart = glutGet(GLUT_ELAPSED_TIME);
+    frameCount++;
+    int now = glutGet(GLUT_ELAPSED_TIME);
+    if (now - windowStart >= 500) {
+        framesPerSecond = frameCount * 1000.0f / (now - windowStart);
+        frameCount = 0;
+        windowStart = now;
+    }
+    
+    // Switch to 2D rendering
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, 1, 0, 1, -1, 1);
+    
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    
+    glDisable(GL_DEPTH_TEST);
+    glColor3f(1.0f, 1.0f, 1.0f);
+    
+    char line[128];
+    snprintf(line, sizeof(line), "FPS: %.1f", framesPerSecond);
+    renderText(0.01f, 0.97f, line);
+    snprintf(line, sizeof(line), "Pos: %.1f, %.1f, %.1f", eyePosition.x, eyePosition.y, eyePosition.z);
+    renderText(0.01f, 0.94f, line);
+    snprintf(line, sizeof(line), "Chunks: %d drawn (%d translucent), %d frustum culled, %d occluded",
+             renderStats.chunksDrawn, renderStats.translucentChunks, renderStats.chunksFrustumCulled,
+             renderStats.chunksOcclusionCulled);
+    renderText(0.01f, 0.91f, line);
+    snprintf(line, sizeof(line), "Detail levels: %d / %d / %d / %d  Render distance: %.0f",
+             renderStats.chunksPerLod[0], renderStats.chunksPerLod[1], renderStats.chunksPerLod[2],
+             renderStats.chunksPerLod[3], getRenderDistance());
+    renderText(0.01f, 0.88f, line);
+    snprintf(line, sizeof(line), "Vertices: %d  Draw calls: %d (%s)  Mesh jobs: %d",
+             renderStats.verticesDrawn, renderStats.drawCalls,
+             chunkDrawLists[0].usesIndirect() ? "indirect" : "per chunk",
+             meshWorkers ? meshWorkers->getJobsInFlight() : 0);
+    renderText(0.01f, 0.85f, line);
+    snprintf(line, sizeof(line), "Geometry arena: %.1f / %.1f MB, %d free blocks, %d relocations",
+             geometryArena.getUsedBytes() / (1024.0 * 1024.0), geometryArena.getCapacityBytes() / (1024.0 * 1024.0),
+             geometryArena.getFreeBlockCount(), geometryArena.getRelocationCount());
+    renderText(0.01f, 0.82f, line);
+    snprintf(line, sizeof(line), "Loaded chunks: %d  Load radius: %d  Columns queued: %d, %d cancelled",
+             (int)world->getLoadedChunkCount(), world->getLoadRadius(), world->getQueuedColumnCount(),
+             world->getCancelledColumnCount());
+    renderText(0.01f, 0.79f, line);
+    const FluidSimulator& fluids = world->getFluids();
+    snprintf(line, sizeof(line), "Water: %d flowing, %d scheduled, %d updates last tick",
+             (int)fluids.getFlowingCount(), (int)fluids.getScheduledCount(), fluids.getLastUpdates());
+    renderText(0.01f, 0.76f, line);
+    
+    glEnable(GL_DEPTH_TEST);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
+
 void Renderer::toggleInventory() {
     showInventory = !showInventory;
     std::cout << (showInventory ? "Inventory opened" : "Inventory closed") << std::endl;
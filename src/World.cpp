@@ -1,143 +1,173 @@
 #include "World.h"
 #include "Chunk.h"
 #include "Block.h"
+#include "Random.h"
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
-World::World() : playerPosition(0.0f, 0.0f, 0.0f) {
-    // Initialize chunks vector
-    chunks.resize(WORLD_WIDTH, std::vector<std::vector<std::shared_ptr<Chunk>>>(
-        WORLD_HEIGHT, std::vector<std::shared_ptr<Chunk>>(WORLD_DEPTH)));
+// Highest block generation can touch (terrain peaks plus trees); chunks and
+// sections above it are left as unallocated air
+const int MAX_TERRAIN_HEIGHT = 64;
+
+// Terrain shape: fractal noise in world units, scaled to a height in blocks
+const float TERRAIN_FREQUENCY = 1.0f / 96.0f;
+const int TERRAIN_OCTAVES = 5;
+const float TERRAIN_BASE_HEIGHT = 12.0f;
+const float TERRAIN_AMPLITUDE = 28.0f;
+
+// Biomes: deserts where a slower noise field rises above the threshold
+const float BIOME_FREQUENCY = 1.0f / 160.0f;
+const int BIOME_OCTAVES = 2;
+const float DESERT_THRESHOLD = 0.25f;
+
+namespace {
+
+std::atomic<uint64_t> nextChunkMapEpoch(1);
+
+// The chunk this thread looked up last. Block access is highly coherent (physics,
+// raycasts, neighbour checks all walk adjacent cells), so most lookups hit here
+// instead of hashing into the chunk map.
+struct ChunkLookupCache {
+    uint64_t epoch;
+    ChunkCoord coord;
+    Chunk* chunk;
+};
+
+thread_local ChunkLookupCache lookupCache = { 0, { 0, 0, 0 }, nullptr };
+
+} // namespace
+
+World::World(uint64_t seed)
+    : chunkMapEpoch(nextChunkMapEpoch++), playerPosition(0.0f, 0.0f, 0.0f),
+      viewDirection(0.0f, 0.0f, -1.0f), loadRadius(DEFAULT_LOAD_RADIUS), seed(seed),
+      terrainNoise(CounterRandom::mix(seed ^ 0x7465727261696E00ull)),
+      biomeNoise(CounterRandom::mix(seed ^ 0x62696F6D65000000ull)), fluids(*this), tickAccumulator(0.0f) {
 }
 
 World::~World() {
-    // Clean up chunks
-    for (int x = 0; x < WORLD_WIDTH; x++) {
-        for (int y = 0; y < WORLD_HEIGHT; y++) {
-            for (int z = 0; z < WORLD_DEPTH; z++) {
-                chunks[x][y][z].reset();
-            }
-        }
-    }
+    // Stop the generator threads before the chunks and noise they use go away
+    generator.reset();
+    chunks.clear();
+    chunkMapChanged();
 }
 
-void World::generateWorld() {
-    std::cout << "Generating rich Minecraft world with biomes..." << std::endl;
-    
+int World::generateChunk(Chunk& chunk, int cx, int cy, int cz) const {
     int totalBlocks = 0;
     
-    // Generate multiple chunks to create a proper world
-    for (int cx = 0; cx < WORLD_WIDTH; cx++) {
-        for (int cy = 0; cy < WORLD_HEIGHT; cy++) {
-            for (int cz = 0; cz < WORLD_DEPTH; cz++) {
-                chunks[cx][cy][cz] = std::make_shared<Chunk>(Vector3(cx, cy, cz));
+    // Nothing to generate in chunks entirely above the terrain
+    if (cy * CHUNK_HEIGHT > MAX_TERRAIN_HEIGHT) return 0;
+    
+    // Coherent height and biome fields for all 16x16 columns of the chunk at once
+    float heightField[CHUNK_WIDTH * CHUNK_DEPTH];
+    float biomeField[CHUNK_WIDTH * CHUNK_DEPTH];
+    terrainNoise.fractalGrid(cx * CHUNK_WIDTH * TERRAIN_FREQUENCY, cz * CHUNK_DEPTH * TERRAIN_FREQUENCY,
+                             TERRAIN_FREQUENCY, TERRAIN_OCTAVES, heightField);
+    biomeNoise.fractalGrid(cx * CHUNK_WIDTH * BIOME_FREQUENCY, cz * CHUNK_DEPTH * BIOME_FREQUENCY,
+                           BIOME_FREQUENCY, BIOME_OCTAVES, biomeField);
+    
+    // Ore placement draws from this chunk's own stream, so the result does not
+    // depend on which thread runs the job or when
+    CounterRandom rng(seed, cx, cy, cz);
+    
+    // Generate terrain for this chunk
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int z = 0; z < CHUNK_DEPTH; z++) {
+            // Calculate world coordinates
+            int worldX = cx * CHUNK_WIDTH + x;
+            int worldZ = cz * CHUNK_DEPTH + z;
+            
+            // Height from fractal noise: broad hills with finer detail layered on top
+            float height = TERRAIN_BASE_HEIGHT + TERRAIN_AMPLITUDE * heightField[x * CHUNK_DEPTH + z];
+            int terrainHeight = (int)height;
+            
+            // Determine biome from a separate low-frequency field
+            bool isDesert = (biomeField[x * CHUNK_DEPTH + z] > DESERT_THRESHOLD);
+            bool isMountain = (height > 18.0f);
+            bool isWater = (terrainHeight < 8);
+            
+            // Generate terrain layers (limit height for performance)
+            for (int y = 0; y < CHUNK_HEIGHT && (cy * CHUNK_HEIGHT + y) <= terrainHeight + 10; y++) {
+                int worldY = cy * CHUNK_HEIGHT + y;
+                BlockType blockType = BlockType::AIR;
                 
-                // Generate terrain for this chunk
-                for (int x = 0; x < CHUNK_WIDTH; x++) {
-                    for (int z = 0; z < CHUNK_DEPTH; z++) {
-                        // Calculate world coordinates
-                        int worldX = cx * CHUNK_WIDTH + x;
-                        int worldZ = cz * CHUNK_DEPTH + z;
-                        
-                        // Complex height map with multiple octaves (now randomized)
-                        float randomOffset1 = (rand() % 1000) / 10000.0f;
-                        float randomOffset2 = (rand() % 1000) / 10000.0f;
-                        float randomOffset3 = (rand() % 1000) / 10000.0f;
-                        
-                        float height = 12.0f + (rand() % 4) - 2; // Base height varies ±2
-                        height += 8.0f * sin((worldX + randomOffset1) * 0.03f) * cos((worldZ + randomOffset1) * 0.03f);  // Large hills
-                        height += 4.0f * sin((worldX + randomOffset2) * 0.1f) * sin((worldZ + randomOffset2) * 0.1f);   // Medium features
-                        height += 2.0f * sin((worldX + randomOffset3) * 0.3f) * cos((worldZ + randomOffset3) * 0.25f); // Small details
-                        int terrainHeight = (int)height;
-                        
-                        // Determine biome based on world coordinates
-                        float biomeNoise = sin(worldX * 0.02f) + cos(worldZ * 0.02f);
-                        bool isDesert = (biomeNoise > 0.5f);
-                        bool isMountain = (height > 18.0f);
-                        bool isWater = (terrainHeight < 8);
+                if (worldY <= terrainHeight) {
+                    // Surface blocks based on biome
+                    if (worldY == terrainHeight) {
+                        if (isWater) {
+                            blockType = BlockType::SAND; // Beach sand
+                        } else if (isDesert) {
+                            blockType = BlockType::SAND; // Desert sand
+                        } else if (isMountain) {
+                            blockType = BlockType::STONE; // Mountain stone
+                        } else {
+                            blockType = BlockType::GRASS; // Normal grass
+                        }
+                    }
+                    // Subsurface layers
+                    else if (worldY > terrainHeight - 4 && worldY > 4) {
+                        if (isDesert) {
+                            blockType = BlockType::SAND;
+                        } else {
+                            blockType = BlockType::DIRT;
+                        }
+                    }
+                    // Deep stone with ores
+                    else {
+                        blockType = BlockType::STONE;
                         
-                        // Generate terrain layers (limit height for performance)
-                        for (int y = 0; y < CHUNK_HEIGHT && (cy * CHUNK_HEIGHT + y) <= terrainHeight + 10; y++) {
-                            int worldY = cy * CHUNK_HEIGHT + y;
-                            BlockType blockType = BlockType::AIR;
-                            
-                            if (worldY <= terrainHeight) {
-                                // Surface blocks based on biome
-                                if (worldY == terrainHeight) {
-                                    if (isWater) {
-                                        blockType = BlockType::SAND; // Beach sand
-                                    } else if (isDesert) {
-                                        blockType = BlockType::SAND; // Desert sand
-                                    } else if (isMountain) {
-                                        blockType = BlockType::STONE; // Mountain stone
-                                    } else {
-                                        blockType = BlockType::GRASS; // Normal grass
-                                    }
-                                }
-                                // Subsurface layers
-                                else if (worldY > terrainHeight - 4 && worldY > 4) {
-                                    if (isDesert) {
-                                        blockType = BlockType::SAND;
-                                    } else {
-                                        blockType = BlockType::DIRT;
-                                    }
-                                }
-                                // Deep stone with ores
-                                else {
-                                    blockType = BlockType::STONE;
-                                    
-                                    // Add random ores
-                                    int oreRandom = rand() % 100;
-                                    if (worldY < 6 && oreRandom < 2) {
-                                        blockType = BlockType::DIAMOND_ORE;
-                                    } else if (worldY < 12 && oreRandom < 5) {
-                                        blockType = BlockType::IRON_ORE;
-                                    } else if (worldY < 20 && oreRandom < 8) {
-                                        blockType = BlockType::COAL_ORE;
-                                    }
-                                }
-                                
-                                chunks[cx][cy][cz]->setBlock(x, y, z, Block(blockType));
-                                totalBlocks++;
-                            }
-                            // Water level
-                            else if (worldY <= 8) {
-                                chunks[cx][cy][cz]->setBlock(x, y, z, Block(BlockType::WATER));
+                        // Add random ores
+                        int oreRandom = rng.nextInt(100);
+                        if (worldY < 6 && oreRandom < 2) {
+                            blockType = BlockType::DIAMOND_ORE;
+                        } else if (worldY < 12 && oreRandom < 5) {
+                            blockType = BlockType::IRON_ORE;
+                        } else if (worldY < 20 && oreRandom < 8) {
+                            blockType = BlockType::COAL_ORE;
+                        }
+                    }
+                    
+                    chunk.setBlock(x, y, z, Block(blockType));
+                    totalBlocks++;
+                }
+                // Water level
+                else if (worldY <= 8) {
+                    chunk.setBlock(x, y, z, Block(BlockType::WATER));
+                    totalBlocks++;
+                }
+            }
+            
+            // Add vegetation
+            if (!isWater && terrainHeight > 8) {
+                // Trees
+                if ((worldX + worldZ) % 25 == 0 && !isDesert && !isMountain) {
+                    // Tree trunk
+                    for (int treeY = terrainHeight + 1; treeY < terrainHeight + 6; treeY++) {
+                        if (treeY < cy * CHUNK_HEIGHT + CHUNK_HEIGHT) {
+                            int localY = treeY - cy * CHUNK_HEIGHT;
+                            if (localY >= 0 && localY < CHUNK_HEIGHT) {
+                                chunk.setBlock(x, localY, z, Block(BlockType::WOOD));
                                 totalBlocks++;
                             }
                         }
-                        
-                        // Add vegetation
-                        if (!isWater && terrainHeight > 8) {
-                            // Trees
-                            if ((worldX + worldZ) % 25 == 0 && !isDesert && !isMountain) {
-                                // Tree trunk
-                                for (int treeY = terrainHeight + 1; treeY < terrainHeight + 6; treeY++) {
-                                    if (treeY < cy * CHUNK_HEIGHT + CHUNK_HEIGHT) {
-                                        int localY = treeY - cy * CHUNK_HEIGHT;
-                                        if (localY >= 0 && localY < CHUNK_HEIGHT) {
-                                            chunks[cx][cy][cz]->setBlock(x, localY, z, Block(BlockType::WOOD));
-                                            totalBlocks++;
-                                        }
-                                    }
-                                }
-                                // Tree leaves
-                                for (int lx = -2; lx <= 2; lx++) {
-                                    for (int lz = -2; lz <= 2; lz++) {
-                                        for (int ly = terrainHeight + 4; ly < terrainHeight + 8; ly++) {
-                                            if (abs(lx) + abs(lz) <= 2 && ly < cy * CHUNK_HEIGHT + CHUNK_HEIGHT) {
-                                                int leafX = x + lx;
-                                                int leafZ = z + lz;
-                                                int localY = ly - cy * CHUNK_HEIGHT;
-                                                
-                                                if (leafX >= 0 && leafX < CHUNK_WIDTH && 
-                                                    leafZ >= 0 && leafZ < CHUNK_DEPTH &&
-                                                    localY >= 0 && localY < CHUNK_HEIGHT) {
-                                                    chunks[cx][cy][cz]->setBlock(leafX, localY, leafZ, Block(BlockType::LEAVES));
-                                                    totalBlocks++;
-                                                }
-                                            }
-                                        }
+                    }
+                    // Tree leaves
+                    for (int lx = -2; lx <= 2; lx++) {
+                        for (int lz = -2; lz <= 2; lz++) {
+                            for (int ly = terrainHeight + 4; ly < terrainHeight + 8; ly++) {
+                                if (abs(lx) + abs(lz) <= 2 && ly < cy * CHUNK_HEIGHT + CHUNK_HEIGHT) {
+                                    int leafX = x + lx;
+                                    int leafZ = z + lz;
+                                    int localY = ly - cy * CHUNK_HEIGHT;
+                                    
+                                    if (leafX >= 0 && leafX < CHUNK_WIDTH && 
+                                        leafZ >= 0 && leafZ < CHUNK_DEPTH &&
+                                        localY >= 0 && localY < CHUNK_HEIGHT) {
+                                        chunk.setBlock(leafX, localY, leafZ, Block(BlockType::LEAVES));
+                                        totalBlocks++;
                                     }
                                 }
                             }
@@ -148,47 +178,366 @@ void World::generateWorld() {
         }
     }
     
-    std::cout << "Generated " << totalBlocks << " blocks with biomes in a " 
-              << WORLD_WIDTH << "x" << WORLD_HEIGHT << "x" << WORLD_DEPTH << " world" << std::endl;
+    return totalBlocks;
 }
 
-void World::update() {
-    // Update world state
+void World::generateWorld(int threadCount) {
+    std::cout << "Generating rich Minecraft world with biomes (seed " << seed << ")..." << std::endl;
+    auto startTime = std::chrono::steady_clock::now();
+    
+    if (threadCount <= 0) {
+        threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // Only the area around the spawn point is generated up front
+    std::vector<ChunkCoord> columns = findMissingColumns(getPlayerColumn(), SPAWN_RADIUS);
+    int totalBlocks = generateColumns(columns, threadCount);
+    
+    size_t storageBytes = 0;
+    for (const auto& entry : chunks) {
+        storageBytes += entry.second->memoryUsage();
+    }
+    
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Generated " << totalBlocks << " blocks with biomes in " << columns.size()
+              << " spawn columns" << std::endl;
+    std::cout << "World generation took " << elapsedMs << " ms on " << threadCount << " thread(s)" << std::endl;
+    std::cout << "Chunk block storage: " << storageBytes / 1024 << " KB" << std::endl;
+    
+    // Everything else out to the load radius streams in from worker threads
+    if (!generator) {
+        generator.reset(new ChunkGenerator([this](Chunk& chunk) {
+            ChunkCoord c = chunk.getCoord();
+            generateChunk(chunk, c.x, c.y, c.z);
+            chunk.compact();
+        }, WORLD_HEIGHT));
+        std::cout << "Streaming chunks within " << loadRadius << " chunks of the player on "
+                  << generator->getThreadCount() << " generator thread(s)" << std::endl;
+    }
 }
 
-Chunk* World::getChunkAt(int x, int y, int z) {
-    // Bounds checking - x,y,z are chunk indices, not world coordinates
-    if (x >= 0 && x < WORLD_WIDTH &&
-        y >= 0 && y < WORLD_HEIGHT &&
-        z >= 0 && z < WORLD_DEPTH) {
-        return chunks[x][y][z].get();
+int World::generateColumns(const std::vector<ChunkCoord>& columns, int threadCount) {
+    // Allocate every chunk up front so jobs only ever touch their own chunk
+    std::vector<Chunk*> jobs;
+    for (const ChunkCoord& column : columns) {
+        for (int cy = 0; cy < WORLD_HEIGHT; cy++) {
+            std::shared_ptr<Chunk>& chunk = chunks[{ column.x, cy, column.z }];
+            chunk = std::make_shared<Chunk>(Vector3(column.x, cy, column.z));
+            jobs.push_back(chunk.get());
+        }
+    }
+    chunkMapChanged();
+    for (Chunk* chunk : jobs) {
+        linkNeighbours(chunk);
+    }
+    threadCount = std::max(1, std::min(threadCount, (int)jobs.size()));
+    
+    // Workers pull chunk jobs off a shared counter; each generates its chunk and
+    // tightens its palettes, and block counts are summed at the end
+    std::atomic<size_t> nextJob(0);
+    std::vector<int> jobBlocks(jobs.size(), 0);
+    auto worker = [&]() {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+            Chunk& chunk = *jobs[i];
+            ChunkCoord c = chunk.getCoord();
+            jobBlocks[i] = generateChunk(chunk, c.x, c.y, c.z);
+            chunk.compact();
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    
+    for (const ChunkCoord& column : columns) {
+        lightColumn(column);
+        markColumnNeighboursDirty(column);
+    }
+    
+    int totalBlocks = 0;
+    for (int blocks : jobBlocks) {
+        totalBlocks += blocks;
+    }
+    return totalBlocks;
+}
+
+ChunkCoord World::getPlayerColumn() const {
+    return { blockToChunkX((int)std::floor(playerPosition.x)), 0,
+             blockToChunkZ((int)std::floor(playerPosition.z)) };
+}
+
+std::vector<ChunkCoord> World::findMissingColumns(ChunkCoord center, int radius) const {
+    std::vector<ChunkCoord> missing;
+    for (int x = center.x - radius; x <= center.x + radius; x++) {
+        for (int z = center.z - radius; z <= center.z + radius; z++) {
+            if (columnInRadius(center, x, z, radius) && !chunks.count({ x, 0, z })) {
+                missing.push_back({ x, 0, z });
+            }
+        }
     }
+    return missing;
+}
+
+float World::columnPriority(ChunkCoord center, ChunkCoord column) const {
+    // Weight for columns straight ahead: they rank as if this much closer
+    const float VIEW_PREFERENCE = 0.4f;
     
-    return nullptr; // Chunk not found
+    float dx = (float)(column.x - center.x);
+    float dz = (float)(column.z - center.z);
+    float distance = std::sqrt(dx * dx + dz * dz);
+    if (distance == 0.0f) return 0.0f;
+    
+    Vector3 view = Vector3(viewDirection.x, 0.0f, viewDirection.z).normalize();
+    float facing = (dx * view.x + dz * view.z) / distance; // -1 behind .. 1 ahead
+    return distance * (1.0f - VIEW_PREFERENCE * facing);
+}
+
+void World::markColumnNeighboursDirty(ChunkCoord column) {
+    // Already-meshed neighbours were built against air where this column now is;
+    // the diagonal ones too, since it sits in the corners of their padding
+    for (int cy = 0; cy < WORLD_HEIGHT; cy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                if (dx != 0 || dz != 0) markChunkDirty(column.x + dx, cy, column.z + dz);
+            }
+        }
+    }
+}
+
+void World::lightColumn(ChunkCoord column) {
+    Chunk* stack[WORLD_HEIGHT];
+    for (int cy = 0; cy < WORLD_HEIGHT; cy++) {
+        stack[cy] = getChunkAt(column.x, cy, column.z);
+        if (!stack[cy]) return;
+    }
+    lighting.lightColumn(stack, WORLD_HEIGHT);
+}
+
+void World::linkNeighbours(Chunk* chunk) {
+    ChunkCoord c = chunk->getCoord();
+    for (int face = 0; face < FACE_COUNT; face++) {
+        Chunk* neighbour = getChunkAt(c.x + FACE_DIRECTIONS[face][0],
+                                      c.y + FACE_DIRECTIONS[face][1],
+                                      c.z + FACE_DIRECTIONS[face][2]);
+        chunk->setNeighbour(face, neighbour);
+        if (neighbour) {
+            neighbour->setNeighbour(oppositeFace(face), chunk);
+        }
+    }
+}
+
+void World::unloadDistantColumns(ChunkCoord center) {
+    // Chunks unlink themselves from their neighbours as they are destroyed
+    int unloadRadius = getUnloadRadius();
+    bool removed = false;
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        if (!columnInRadius(center, it->first.x, it->first.z, unloadRadius)) {
+            it = chunks.erase(it);
+            removed = true;
+        } else {
+            ++it;
+        }
+    }
+    if (removed) {
+        chunkMapChanged();
+        fluids.dropUnloaded();
+    }
+}
+
+void World::update(float deltaTime) {
+    // Finished columns moved into the map per call; inserting is cheap, this only
+    // bounds the neighbour remeshing a burst of arrivals triggers in one frame
+    const int MAX_COLUMNS_PER_UPDATE = 8;
+    const float TICK_SECONDS = 1.0f / TICKS_PER_SECOND;
+    
+    tickAccumulator += deltaTime;
+    int ticks = 0;
+    while (tickAccumulator >= TICK_SECONDS && ticks < MAX_TICKS_PER_UPDATE) {
+        tickAccumulator -= TICK_SECONDS;
+        fluids.tick();
+        ticks++;
+    }
+    tickAccumulator = std::min(tickAccumulator, TICK_SECONDS);
+    
+    ChunkCoord center = getPlayerColumn();
+    unloadDistantColumns(center);
+    if (!generator) return;
+    
+    GeneratedColumn finished;
+    for (int i = 0; i < MAX_COLUMNS_PER_UPDATE && generator->pollResult(finished); i++) {
+        // The player may have moved on while it was generated
+        if (!columnInRadius(center, finished.column.x, finished.column.z, getUnloadRadius())) continue;
+        if (chunks.count(finished.column)) continue;
+        
+        for (int cy = 0; cy < WORLD_HEIGHT; cy++) {
+            chunks[{ finished.column.x, cy, finished.column.z }] = finished.chunks[cy];
+        }
+        chunkMapChanged();
+        for (int cy = 0; cy < WORLD_HEIGHT; cy++) {
+            linkNeighbours(finished.chunks[cy].get());
+        }
+        lightColumn(finished.column);
+        markColumnNeighboursDirty(finished.column);
+    }
+    
+    // Re-rank everything still missing; waiting jobs for columns that are no
+    // longer wanted are dropped by the generator
+    std::vector<ChunkCoord> missing = findMissingColumns(center, loadRadius);
+    std::vector<ColumnJob> jobs;
+    jobs.reserve(missing.size());
+    for (const ChunkCoord& column : missing) {
+        jobs.push_back({ column, columnPriority(center, column) });
+    }
+    generator->schedule(std::move(jobs));
 }
 
-Block* World::getBlockAt(int x, int y, int z) {
-    // Convert world coordinates to chunk indices
-    int chunkX = x / CHUNK_WIDTH;
-    int chunkY = y / CHUNK_HEIGHT;
-    int chunkZ = z / CHUNK_DEPTH;
+void World::chunkMapChanged() {
+    chunkMapEpoch = nextChunkMapEpoch++;
+}
+
+Chunk* World::getChunkAt(int x, int y, int z) {
+    // x,y,z are chunk indices, not world coordinates
+    ChunkLookupCache& cache = lookupCache;
+    if (cache.epoch == chunkMapEpoch && cache.coord.x == x && cache.coord.y == y && cache.coord.z == z) {
+        return cache.chunk;
+    }
+    
+    auto it = chunks.find({ x, y, z });
+    Chunk* chunk = (it != chunks.end()) ? it->second.get() : nullptr; // Null if not loaded
     
+    cache.epoch = chunkMapEpoch;
+    cache.coord = { x, y, z };
+    cache.chunk = chunk;
+    return chunk;
+}
+
+Block World::getBlockAt(int x, int y, int z) {
     // Get chunk that contains this block
-    Chunk* chunk = getChunkAt(chunkX, chunkY, chunkZ);
+    Chunk* chunk = getChunkAt(blockToChunkX(x), blockToChunkY(y), blockToChunkZ(z));
     if (chunk) {
-        // Convert world coordinates to chunk-relative coordinates
-        int localX = x % CHUNK_WIDTH;
-        int localY = y % CHUNK_HEIGHT;
-        int localZ = z % CHUNK_DEPTH;
+        return chunk->getBlockUnchecked(blockToLocalX(x), blockToLocalY(y), blockToLocalZ(z));
+    }
+    
+    return Block(); // Unloaded space is air
+}
+
+bool World::isBlockSolidAt(int x, int y, int z) {
+    Chunk* chunk = getChunkAt(blockToChunkX(x), blockToChunkY(y), blockToChunkZ(z));
+    return chunk && chunk->isBlockSolid(blockToLocalX(x), blockToLocalY(y), blockToLocalZ(z));
+}
+
+bool World::raycast(const Vector3& origin, const Vector3& direction, float maxDistance, RaycastHit& hit) {
+    Vector3 dir = direction.normalize();
+    if (dir.length() == 0.0f) return false;
+    
+    // Amanatides & Woo: step into whichever neighbouring voxel the ray reaches first,
+    // so each voxel along the line costs one comparison and one block lookup
+    const float o[3] = { origin.x, origin.y, origin.z };
+    const float d[3] = { dir.x, dir.y, dir.z };
+    int voxel[3], step[3];
+    float tMax[3], tDelta[3];
+    for (int axis = 0; axis < 3; axis++) {
+        voxel[axis] = (int)std::floor(o[axis]);
+        if (d[axis] > 0.0f) {
+            step[axis] = 1;
+            tDelta[axis] = 1.0f / d[axis];
+            tMax[axis] = (voxel[axis] + 1 - o[axis]) * tDelta[axis];
+        } else if (d[axis] < 0.0f) {
+            step[axis] = -1;
+            tDelta[axis] = -1.0f / d[axis];
+            tMax[axis] = (o[axis] - voxel[axis]) * tDelta[axis];
+        } else {
+            step[axis] = 0;
+            tDelta[axis] = INFINITY;
+            tMax[axis] = INFINITY;
+        }
+    }
+    
+    int normal[3] = { 0, 0, 0 };
+    float t = 0.0f;
+    while (true) {
+        Block block = getBlockAt(voxel[0], voxel[1], voxel[2]);
+        if (!block.isEmpty()) {
+            hit.x = voxel[0];
+            hit.y = voxel[1];
+            hit.z = voxel[2];
+            hit.normalX = normal[0];
+            hit.normalY = normal[1];
+            hit.normalZ = normal[2];
+            hit.distance = t;
+            hit.block = block;
+            return true;
+        }
         
-        // Handle negative coordinates properly
-        if (x < 0) localX = CHUNK_WIDTH + localX;
-        if (y < 0) localY = CHUNK_HEIGHT + localY;
-        if (z < 0) localZ = CHUNK_DEPTH + localZ;
+        int axis = 0;
+        if (tMax[1] < tMax[axis]) axis = 1;
+        if (tMax[2] < tMax[axis]) axis = 2;
         
-        // Return reference to block
-        return &chunk->getBlock(localX, localY, localZ);
+        t = tMax[axis];
+        if (t > maxDistance) return false;
+        
+        voxel[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+        normal[0] = normal[1] = normal[2] = 0;
+        normal[axis] = -step[axis];
+    }
+}
+
+void World::markChunkDirty(int x, int y, int z) {
+    Chunk* chunk = getChunkAt(x, y, z);
+    if (chunk) {
+        chunk->markDirty();
     }
+}
+
+int World::getSurfaceHeight(int x, int z) {
+    // Walk down the chunk column; each chunk answers from its opaque column mask
+    for (int cy = WORLD_HEIGHT - 1; cy >= 0; cy--) {
+        Chunk* chunk = getChunkAt(blockToChunkX(x), cy, blockToChunkZ(z));
+        if (!chunk) continue;
+        
+        int localY = chunk->getHighestSolidY(blockToLocalX(x), blockToLocalZ(z));
+        if (localY >= 0) {
+            return cy * CHUNK_HEIGHT + localY;
+        }
+    }
+    return -1;
+}
+
+bool World::setBlockAt(int x, int y, int z, Block block) {
+    Chunk* chunk = getChunkAt(blockToChunkX(x), blockToChunkY(y), blockToChunkZ(z));
+    if (!chunk) return false;
+    
+    int localX = blockToLocalX(x);
+    int localY = blockToLocalY(y);
+    int localZ = blockToLocalZ(z);
+    BlockType oldType = chunk->getBlockUnchecked(localX, localY, localZ).type;
+    uint32_t revision = chunk->getRevision();
+    chunk->setBlock(localX, localY, localZ, block);
+    if (chunk->getRevision() == revision) return true;
     
-    return nullptr; // Block not found
+    // Only the light that passed through this block is redone
+    lighting.blockChanged(chunk, localX, localY, localZ, oldType, block.type);
+    fluids.blockChanged(x, y, z);
+    
+    // Edits on a chunk border land in the padding of every chunk across it:
+    // the face neighbours for culling, and the edge and corner ones for their
+    // ambient occlusion
+    ChunkCoord c = chunk->getCoord();
+    int minX = (localX == 0) ? -1 : 0, maxX = (localX == CHUNK_WIDTH - 1) ? 1 : 0;
+    int minY = (localY == 0) ? -1 : 0, maxY = (localY == CHUNK_HEIGHT - 1) ? 1 : 0;
+    int minZ = (localZ == 0) ? -1 : 0, maxZ = (localZ == CHUNK_DEPTH - 1) ? 1 : 0;
+    for (int dx = minX; dx <= maxX; dx++) {
+        for (int dy = minY; dy <= maxY; dy++) {
+            for (int dz = minZ; dz <= maxZ; dz++) {
+                if (dx != 0 || dy != 0 || dz != 0) markChunkDirty(c.x + dx, c.y + dy, c.z + dz);
+            }
+        }
+    }
+    return true;
 }
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <chrono>
 #include "Renderer.h"
 #include "World.h"
 
@@ -11,6 +12,11 @@
 Renderer* renderer = nullptr;
 World* world = nullptr;
 
+// Physics runs in fixed steps however fast frames come; rendering draws the
+// camera between the last two steps
+const float FIXED_TIMESTEP = 1.0f / 60.0f;
+const int MAX_STEPS_PER_FRAME = 5; // After a longer stall the simulation slows rather than spiralling
+
 // GLUT callbacks
 void display() {
     if (renderer) {
@@ -19,8 +25,35 @@ void display() {
 }
 
 void idle() {
+    using Clock = std::chrono::steady_clock;
+    static Clock::time_point lastTime = Clock::now();
+    static float accumulator = 0.0f;
+    
+    Clock::time_point now = Clock::now();
+    accumulator += std::chrono::duration<float>(now - lastTime).count();
+    lastTime = now;
+    
+    int steps = 0;
+    while (accumulator >= FIXED_TIMESTEP && steps < MAX_STEPS_PER_FRAME) {
+        if (renderer) {
+            renderer->update(FIXED_TIMESTEP);
+        }
+        accumulator -= FIXED_TIMESTEP;
+        steps++;
+    }
+    if (steps == MAX_STEPS_PER_FRAME && accumulator >= FIXED_TIMESTEP) {
+        accumulator = 0.0f; // Drop the backlog
+    }
     if (renderer) {
-        renderer->update(0.016f); // ~60 FPS
+        renderer->setInterpolation(accumulator / FIXED_TIMESTEP);
+    }
+    
+    if (renderer && world && steps > 0) {
+        // Stream chunks in and out around the player and run block ticks
+        float yawRad = renderer->getCameraYaw() * 3.14159f / 180.0f;
+        world->setPlayerPosition(renderer->getCameraPosition());
+        world->setViewDirection(Vector3(-sin(yawRad), 0.0f, -cos(yawRad)));
+        world->update(steps * FIXED_TIMESTEP);
     }
     glutPostRedisplay();
 }
@@ -165,7 +198,8 @@ void mouse(int button, int state, int x, int y) {
     }
     
     if (state == GLUT_DOWN && renderer && world) {
-        Vector3 pos = renderer->getCameraPosition();
+        // Aim from the eye the clicked frame was drawn from
+        Vector3 pos = renderer->getEyePosition();
         
         // Get camera direction from renderer
         float cameraYaw = renderer->getCameraYaw();
@@ -181,53 +215,29 @@ void mouse(int button, int state, int x, int y) {
         
         std::cout << "Ray direction: (" << rayX << "," << rayY << "," << rayZ << ")" << std::endl;
         
-        // Raycast forward to find block
-        float stepSize = 0.1f;
-        float maxDistance = 5.0f;
-        std::cout << "Starting raycast from (" << pos.x << "," << pos.y << "," << pos.z << ")" << std::endl;
+        const float REACH_DISTANCE = 5.0f;
+        RaycastHit hit;
+        bool found = world->raycast(pos, Vector3(rayX, rayY, rayZ), REACH_DISTANCE, hit);
         
-        // Simple test: just try blocks directly in front of player
         if (button == GLUT_LEFT_BUTTON) {
-            std::cout << "Left click detected - triggering arm swing" << std::endl;
             renderer->triggerArmSwing();
             
-            // Try breaking block directly in front
-            int testX = (int)(pos.x + rayX * 2.0f);
-            int testY = (int)(pos.y + rayY * 2.0f);  
-            int testZ = (int)(pos.z + rayZ * 2.0f);
-            
-            Block* testBlock = world->getBlockAt(testX, testY, testZ);
-            if (testBlock && !testBlock->isEmpty()) {
-                *testBlock = Block(BlockType::AIR);
-                std::cout << "Broke test block at (" << testX << "," << testY << "," << testZ << ")" << std::endl;
-            } else {
-                std::cout << "No block found at (" << testX << "," << testY << "," << testZ << ")" << std::endl;
+            if (found) {
+                world->setBlockAt(hit.x, hit.y, hit.z, Block(BlockType::AIR));
+                std::cout << "Broke " << hit.block.toString() << " at (" << hit.x << "," << hit.y << "," << hit.z << ")" << std::endl;
             }
-        }
-        
-        // Original raycast code for more precise detection
-        for (float dist = 0.5f; dist < maxDistance; dist += stepSize) {
-            int blockX = (int)(pos.x + rayX * dist);
-            int blockY = (int)(pos.y + rayY * dist);
-            int blockZ = (int)(pos.z + rayZ * dist);
+        } else if (button == GLUT_RIGHT_BUTTON && found) {
+            // Place against the face the ray hit
+            int placeX = hit.x + hit.normalX;
+            int placeY = hit.y + hit.normalY;
+            int placeZ = hit.z + hit.normalZ;
             
-            Block* block = world->getBlockAt(blockX, blockY, blockZ);
-            if (block && !block->isEmpty()) {
-                if (button == GLUT_RIGHT_BUTTON) {
-                    // Place block one step back
-                    int placeX = (int)(pos.x + rayX * (dist - stepSize));
-                    int placeY = (int)(pos.y + rayY * (dist - stepSize));
-                    int placeZ = (int)(pos.z + rayZ * (dist - stepSize));
-                    
-                    Block* placeBlock = world->getBlockAt(placeX, placeY, placeZ);
-                    if (placeBlock && placeBlock->isEmpty()) {
-                        // Trigger arm swing animation for placement too
-                        renderer->triggerArmSwing();
-                        *placeBlock = Block(selectedBlockType);
-                        std::cout << "Placed " << placeBlock->toString() << " at (" << placeX << "," << placeY << "," << placeZ << ")" << std::endl;
-                    }
-                }
-                break; // Stop at first solid block
+            bool insideHitBlock = hit.normalX == 0 && hit.normalY == 0 && hit.normalZ == 0;
+            Block placeBlock = world->getBlockAt(placeX, placeY, placeZ);
+            if (!insideHitBlock && placeBlock.isEmpty() && world->setBlockAt(placeX, placeY, placeZ, Block(selectedBlockType))) {
+                // Trigger arm swing animation for placement too
+                renderer->triggerArmSwing();
+                std::cout << "Placed " << Block(selectedBlockType).toString() << " at (" << placeX << "," << placeY << "," << placeZ << ")" << std::endl;
             }
         }
     }
@@ -265,12 +275,11 @@ void motion(int x, int y) {
 
 
 int main(int argc, char** argv) {
-    // Initialize random seed for world generation
-    srand(time(nullptr));
+    // World seed: a fresh one every launch unless one is given on the command line
+    uint64_t worldSeed = (uint64_t)time(nullptr);
     
     std::cout << "MY-CRAFT by Kelsi Davis - Started!" << std::endl;
     std::cout << "High Resolution Voxel World with Physics & Biomes!" << std::endl;
-    std::cout << "Random seed: " << time(nullptr) << std::endl;
     std::cout << "Controls:" << std::endl;
     std::cout << "  WASD - Move with physics (gravity & swimming)" << std::endl;
     std::cout << "  Space - Jump/Swim up, C - Swim down/Creative fly down" << std::endl;
@@ -281,10 +290,14 @@ int main(int argc, char** argv) {
     std::cout << "  R/T/Y - Wireframe/Solid/Textured render modes" << std::endl;
     std::cout << "  F - Toggle Flight Mode (Free floating)" << std::endl;
     std::cout << "  ESC - Settings Menu" << std::endl;
-    std::cout << "World: 128x1024x128 blocks with biomes, ores, trees, water!" << std::endl;
+    std::cout << "World: endless terrain with biomes, ores, trees, water!" << std::endl;
+    std::cout << "Usage: minecraft [seed]" << std::endl;
     
     // Initialize GLUT
     glutInit(&argc, argv);
+    if (argc > 1) {
+        worldSeed = strtoull(argv[1], nullptr, 0);
+    }
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(1920, 1080);
     glutInitWindowPosition(100, 100);
@@ -295,11 +308,15 @@ int main(int argc, char** argv) {
     glClearColor(0.5f, 0.8f, 1.0f, 1.0f); // Sky blue background
     
     // Create game objects
-    world = new World();
+    world = new World(worldSeed);
     world->generateWorld();
     
     renderer = new Renderer(world);
-    renderer->init();
+    if (!renderer->init()) {
+        delete renderer;
+        delete world;
+        return EXIT_FAILURE;
+    }
     renderer->initPlayerPosition(); // Set player on solid ground
     
     // Register callbacks